@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include "log.hpp"
+#include "memory_arena.hpp"
+
+#if defined(WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <cstring>
+#include <new>
+#endif
+
+namespace common {
+
+static constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+
+static auto AlignUp(std::size_t value, std::size_t alignment) -> std::size_t {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+#if defined(WIN32)
+
+auto AllocatePages(std::size_t size, PageOptions const& options) -> PagePtr {
+  void* address;
+
+  // Large pages require SeLockMemoryPrivilege, which normal users do not hold,
+  // so only the NUMA placement is honored on Windows.
+  if (options.numa_node >= 0) {
+    address = VirtualAllocExNuma(GetCurrentProcess(), nullptr, size,
+      MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, DWORD(options.numa_node));
+  } else {
+    address = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+  }
+
+  ASSERT(address != nullptr, "AllocatePages: failed to allocate {0} bytes.", size);
+
+  return PagePtr{ static_cast<std::uint8_t*>(address), PageDeleter{ size } };
+}
+
+void PageDeleter::operator()(std::uint8_t* address) const {
+  VirtualFree(address, 0, MEM_RELEASE);
+}
+
+#elif defined(__linux__)
+
+static auto MapAnonymous(std::size_t size, int flags) -> void* {
+  return mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+}
+
+auto AllocatePages(std::size_t size, PageOptions const& options) -> PagePtr {
+  void* address = MAP_FAILED;
+  auto mapped_size = AlignUp(size, options.huge_pages ? kHugePageSize : std::size_t(sysconf(_SC_PAGESIZE)));
+
+  if (options.huge_pages) {
+#ifdef MAP_HUGETLB
+    address = MapAnonymous(mapped_size, MAP_HUGETLB);
+#endif
+
+    /* Fall back to transparent huge pages if no explicit huge pages are reserved.
+     * The mapping is over-allocated and trimmed so that it starts on a huge page boundary.
+     */
+    if (address == MAP_FAILED) {
+      auto base = static_cast<std::uint8_t*>(MapAnonymous(mapped_size + kHugePageSize, 0));
+
+      if (base != MAP_FAILED) {
+        auto head = AlignUp(std::uintptr_t(base), kHugePageSize) - std::uintptr_t(base);
+
+        if (head != 0) {
+          munmap(base, head);
+        }
+        munmap(base + head + mapped_size, kHugePageSize - head);
+        address = base + head;
+#ifdef MADV_HUGEPAGE
+        madvise(address, mapped_size, MADV_HUGEPAGE);
+#endif
+      }
+    }
+  } else {
+    address = MapAnonymous(mapped_size, 0);
+  }
+
+  ASSERT(address != MAP_FAILED, "AllocatePages: failed to allocate {0} bytes.", size);
+
+  // The pages have not been touched yet, so the policy applies to all of them.
+  if (options.numa_node >= 0) {
+    unsigned long nodemask = 1UL << (options.numa_node % (sizeof(nodemask) * 8));
+
+    if (options.numa_node >= int(sizeof(nodemask) * 8) ||
+        syscall(SYS_mbind, address, mapped_size, MPOL_PREFERRED, &nodemask, sizeof(nodemask) * 8 + 1, 0) != 0) {
+      LOG_WARN("AllocatePages: unable to place memory on NUMA node {0}.", options.numa_node);
+    }
+  }
+
+  return PagePtr{ static_cast<std::uint8_t*>(address), PageDeleter{ mapped_size } };
+}
+
+void PageDeleter::operator()(std::uint8_t* address) const {
+  munmap(address, size);
+}
+
+#else
+
+static constexpr std::size_t kPageSize = 4096;
+
+auto AllocatePages(std::size_t size, PageOptions const& options) -> PagePtr {
+  auto address = static_cast<std::uint8_t*>(::operator new(size, std::align_val_t{ kPageSize }));
+
+  std::memset(address, 0, size);
+
+  return PagePtr{ address, PageDeleter{ size } };
+}
+
+void PageDeleter::operator()(std::uint8_t* address) const {
+  ::operator delete(address, std::align_val_t{ kPageSize });
+}
+
+#endif
+
+auto MemoryArena::Allocate(std::size_t size, std::size_t alignment) -> std::uint8_t* {
+  auto address = AlignUp(offset, alignment);
+
+  ASSERT(address + size <= capacity, "MemoryArena: cannot allocate {0} bytes, {1} of {2} bytes in use.", size, offset, capacity);
+
+  offset = address + size;
+  return &pages[address];
+}
+
+} // namespace common
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace common {
+
+struct PageOptions {
+  // Back the memory with huge pages if the OS provides them.
+  bool huge_pages = true;
+
+  // NUMA node to place the memory on, or -1 for the default (first-touch) policy.
+  int numa_node = -1;
+};
+
+struct PageDeleter {
+  std::size_t size = 0;
+
+  void operator()(std::uint8_t* address) const;
+};
+
+using PagePtr = std::unique_ptr<std::uint8_t[], PageDeleter>;
+
+/* Allocate zero-initialized memory directly from the OS.
+ * With huge pages enabled, explicit huge pages are tried first and transparent
+ * huge pages are used as a fallback. If neither is available, regular pages are used.
+ */
+auto AllocatePages(std::size_t size, PageOptions const& options = {}) -> PagePtr;
+
+/* Bump allocator that carves regions out of one page allocation,
+ * so that all regions share as few (huge) pages as possible.
+ */
+class MemoryArena {
+public:
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  MemoryArena(std::size_t capacity, PageOptions const& options = {})
+      : pages(AllocatePages(capacity, options))
+      , capacity(capacity) {
+  }
+
+  auto Allocate(std::size_t size, std::size_t alignment = kCacheLineSize) -> std::uint8_t*;
+
+private:
+  PagePtr pages;
+  std::size_t capacity;
+  std::size_t offset = 0;
+};
+
+} // namespace common
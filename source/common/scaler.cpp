@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#endif
+
+#include "scaler.hpp"
+
+namespace common {
+
+namespace {
+
+/* Scale2x of one pixel E, given its neighbours B (above), D (left), F (right) and H (below). */
+inline void Scale2xPixel(std::uint32_t b, std::uint32_t d, std::uint32_t e, std::uint32_t f, std::uint32_t h,
+                         std::uint32_t* out0, std::uint32_t* out1) {
+  if (b != h && d != f) {
+    out0[0] = d == b ? d : e;
+    out0[1] = b == f ? f : e;
+    out1[0] = d == h ? d : e;
+    out1[1] = h == f ? f : e;
+  } else {
+    out0[0] = out0[1] = e;
+    out1[0] = out1[1] = e;
+  }
+}
+
+/* Scale3x of one pixel, given the three pixels above, at and below it, each starting left of it. */
+inline void Scale3xPixel(std::uint32_t const* above, std::uint32_t const* row, std::uint32_t const* below,
+                         std::uint32_t* out0, std::uint32_t* out1, std::uint32_t* out2) {
+  /* A B C
+   * D E F
+   * G H I
+   */
+  auto a = above[0], b = above[1], c = above[2];
+  auto d = row[0],   e = row[1],   f = row[2];
+  auto g = below[0], h = below[1], i = below[2];
+
+  if (b != h && d != f) {
+    out0[0] = d == b ? d : e;
+    out0[1] = (d == b && e != c) || (b == f && e != a) ? b : e;
+    out0[2] = b == f ? f : e;
+    out1[0] = (d == b && e != g) || (d == h && e != a) ? d : e;
+    out1[1] = e;
+    out1[2] = (b == f && e != i) || (h == f && e != c) ? f : e;
+    out2[0] = d == h ? d : e;
+    out2[1] = (d == h && e != i) || (h == f && e != g) ? h : e;
+    out2[2] = h == f ? f : e;
+  } else {
+    std::fill_n(out0, 3, e);
+    std::fill_n(out1, 3, e);
+    std::fill_n(out2, 3, e);
+  }
+}
+
+/* Copies a row with its edge pixels repeated, so that every pixel has a left and right neighbour. */
+inline void PadRow(std::uint32_t const* src, int width, std::uint32_t* dst) {
+  std::memcpy(&dst[1], src, width * sizeof(std::uint32_t));
+  dst[0] = src[0];
+  dst[width + 1] = src[width - 1];
+}
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+
+inline auto Select(__m128i mask, __m128i a, __m128i b) -> __m128i {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/* Stores x0 y0 z0 x1 y1 z1 ... z3, i.e. three vectors of pixels interleaved. */
+inline void Store3(std::uint32_t* dst, __m128i x, __m128i y, __m128i z) {
+  auto xy_lo = _mm_castsi128_ps(_mm_unpacklo_epi32(x, y));
+  auto xy_hi = _mm_castsi128_ps(_mm_unpackhi_epi32(x, y));
+  auto yz_lo = _mm_castsi128_ps(_mm_unpacklo_epi32(y, z));
+  auto yz_hi = _mm_castsi128_ps(_mm_unpackhi_epi32(y, z));
+  auto zx_0 = _mm_shuffle_ps(_mm_castsi128_ps(z), _mm_castsi128_ps(x), _MM_SHUFFLE(1, 1, 0, 0));
+  auto zx_2 = _mm_shuffle_ps(_mm_castsi128_ps(z), _mm_castsi128_ps(x), _MM_SHUFFLE(3, 3, 2, 2));
+
+  _mm_storeu_ps((float*)&dst[0], _mm_shuffle_ps(xy_lo, zx_0, _MM_SHUFFLE(2, 0, 1, 0)));
+  _mm_storeu_ps((float*)&dst[4], _mm_shuffle_ps(yz_lo, xy_hi, _MM_SHUFFLE(1, 0, 3, 2)));
+  _mm_storeu_ps((float*)&dst[8], _mm_shuffle_ps(zx_2, yz_hi, _MM_SHUFFLE(3, 2, 2, 0)));
+}
+
+#endif
+
+} // anonymous namespace
+
+Scaler::Scaler(Filter filter, int factor, int threads)
+    : filter(filter)
+    , factor(std::clamp(factor, 1, 4))
+    , pool(threads) {
+}
+
+void Scaler::Scale(std::uint32_t const* input, int width, int height, std::uint32_t* output) {
+  if (filter == Filter::Nearest || factor == 1) {
+    Nearest(input, width, height, output);
+    return;
+  }
+
+  switch (factor) {
+    case 2:
+      Scale2x(input, width, height, output);
+      break;
+    case 3:
+      Scale3x(input, width, height, output);
+      break;
+    case 4:
+      intermediate.resize(width * height * 4);
+      Scale2x(input, width, height, intermediate.data());
+      Scale2x(intermediate.data(), width * 2, height * 2, output);
+      break;
+  }
+}
+
+void Scaler::ForEachBand(int height, std::function<void(int first, int last)> const& task) {
+  int bands = pool.Size();
+  int band_height = (height + bands - 1) / bands;
+
+  pool.Run(bands, [&](int band) {
+    int first = band * band_height;
+    int last = std::min(first + band_height, height);
+
+    if (first < last) {
+      task(first, last);
+    }
+  });
+}
+
+void Scaler::Nearest(std::uint32_t const* input, int width, int height, std::uint32_t* output) {
+  ForEachBand(height, [&](int first, int last) {
+    int out_width = width * factor;
+
+    for (int y = first; y < last; y++) {
+      auto src = &input[y * width];
+      auto dst = &output[y * factor * out_width];
+      int x = 0;
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+      for (; x + 4 <= width; x += 4) {
+        auto pixels = _mm_loadu_si128((__m128i const*)&src[x]);
+        auto out = (__m128i*)&dst[x * factor];
+
+        switch (factor) {
+          case 1:
+            _mm_storeu_si128(out, pixels);
+            break;
+          case 2:
+            _mm_storeu_si128(out + 0, _mm_unpacklo_epi32(pixels, pixels));
+            _mm_storeu_si128(out + 1, _mm_unpackhi_epi32(pixels, pixels));
+            break;
+          case 3:
+            _mm_storeu_si128(out + 0, _mm_shuffle_epi32(pixels, _MM_SHUFFLE(1, 0, 0, 0)));
+            _mm_storeu_si128(out + 1, _mm_shuffle_epi32(pixels, _MM_SHUFFLE(2, 2, 1, 1)));
+            _mm_storeu_si128(out + 2, _mm_shuffle_epi32(pixels, _MM_SHUFFLE(3, 3, 3, 2)));
+            break;
+          case 4:
+            _mm_storeu_si128(out + 0, _mm_shuffle_epi32(pixels, _MM_SHUFFLE(0, 0, 0, 0)));
+            _mm_storeu_si128(out + 1, _mm_shuffle_epi32(pixels, _MM_SHUFFLE(1, 1, 1, 1)));
+            _mm_storeu_si128(out + 2, _mm_shuffle_epi32(pixels, _MM_SHUFFLE(2, 2, 2, 2)));
+            _mm_storeu_si128(out + 3, _mm_shuffle_epi32(pixels, _MM_SHUFFLE(3, 3, 3, 3)));
+            break;
+        }
+      }
+#endif
+
+      for (; x < width; x++) {
+        std::fill_n(&dst[x * factor], factor, src[x]);
+      }
+
+      /* The remaining rows are copies of the first one. */
+      for (int i = 1; i < factor; i++) {
+        std::memcpy(&dst[i * out_width], dst, out_width * sizeof(std::uint32_t));
+      }
+    }
+  });
+}
+
+void Scaler::Scale2x(std::uint32_t const* input, int width, int height, std::uint32_t* output) {
+  ForEachBand(height, [&](int first, int last) {
+    std::vector<std::uint32_t> row(width + 2);
+
+    for (int y = first; y < last; y++) {
+      auto above = &input[std::max(y - 1, 0) * width];
+      auto below = &input[std::min(y + 1, height - 1) * width];
+      auto out0 = &output[y * 2 * width * 2];
+      auto out1 = out0 + width * 2;
+      int x = 0;
+
+      PadRow(&input[y * width], width, row.data());
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+      for (; x + 4 <= width; x += 4) {
+        auto b = _mm_loadu_si128((__m128i const*)&above[x]);
+        auto d = _mm_loadu_si128((__m128i const*)&row[x + 0]);
+        auto e = _mm_loadu_si128((__m128i const*)&row[x + 1]);
+        auto f = _mm_loadu_si128((__m128i const*)&row[x + 2]);
+        auto h = _mm_loadu_si128((__m128i const*)&below[x]);
+
+        /* Pixels are only changed if neither B equals H nor D equals F. */
+        auto change = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi32(b, h), _mm_cmpeq_epi32(d, f)), _mm_set1_epi32(-1));
+
+        auto e0 = Select(_mm_and_si128(change, _mm_cmpeq_epi32(d, b)), d, e);
+        auto e1 = Select(_mm_and_si128(change, _mm_cmpeq_epi32(b, f)), f, e);
+        auto e2 = Select(_mm_and_si128(change, _mm_cmpeq_epi32(d, h)), d, e);
+        auto e3 = Select(_mm_and_si128(change, _mm_cmpeq_epi32(h, f)), f, e);
+
+        _mm_storeu_si128((__m128i*)&out0[x * 2 + 0], _mm_unpacklo_epi32(e0, e1));
+        _mm_storeu_si128((__m128i*)&out0[x * 2 + 4], _mm_unpackhi_epi32(e0, e1));
+        _mm_storeu_si128((__m128i*)&out1[x * 2 + 0], _mm_unpacklo_epi32(e2, e3));
+        _mm_storeu_si128((__m128i*)&out1[x * 2 + 4], _mm_unpackhi_epi32(e2, e3));
+      }
+#endif
+
+      for (; x < width; x++) {
+        Scale2xPixel(above[x], row[x], row[x + 1], row[x + 2], below[x], &out0[x * 2], &out1[x * 2]);
+      }
+    }
+  });
+}
+
+void Scaler::Scale3x(std::uint32_t const* input, int width, int height, std::uint32_t* output) {
+  ForEachBand(height, [&](int first, int last) {
+    /* Rows above, at and below the line, with their edge pixels repeated. */
+    std::vector<std::uint32_t> rows[3];
+
+    for (auto& row : rows) {
+      row.resize(width + 2);
+    }
+
+    for (int y = first; y < last; y++) {
+      auto above = rows[0].data();
+      auto row = rows[1].data();
+      auto below = rows[2].data();
+      auto out0 = &output[y * 3 * width * 3];
+      auto out1 = out0 + width * 3;
+      auto out2 = out1 + width * 3;
+      int x = 0;
+
+      PadRow(&input[std::max(y - 1, 0) * width], width, above);
+      PadRow(&input[y * width], width, row);
+      PadRow(&input[std::min(y + 1, height - 1) * width], width, below);
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+      for (; x + 4 <= width; x += 4) {
+        auto a = _mm_loadu_si128((__m128i const*)&above[x + 0]);
+        auto b = _mm_loadu_si128((__m128i const*)&above[x + 1]);
+        auto c = _mm_loadu_si128((__m128i const*)&above[x + 2]);
+        auto d = _mm_loadu_si128((__m128i const*)&row[x + 0]);
+        auto e = _mm_loadu_si128((__m128i const*)&row[x + 1]);
+        auto f = _mm_loadu_si128((__m128i const*)&row[x + 2]);
+        auto g = _mm_loadu_si128((__m128i const*)&below[x + 0]);
+        auto h = _mm_loadu_si128((__m128i const*)&below[x + 1]);
+        auto i = _mm_loadu_si128((__m128i const*)&below[x + 2]);
+
+        auto change = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi32(b, h), _mm_cmpeq_epi32(d, f)), _mm_set1_epi32(-1));
+
+        auto db = _mm_and_si128(change, _mm_cmpeq_epi32(d, b));
+        auto bf = _mm_and_si128(change, _mm_cmpeq_epi32(b, f));
+        auto dh = _mm_and_si128(change, _mm_cmpeq_epi32(d, h));
+        auto hf = _mm_and_si128(change, _mm_cmpeq_epi32(h, f));
+
+        auto ea = _mm_cmpeq_epi32(e, a);
+        auto ec = _mm_cmpeq_epi32(e, c);
+        auto eg = _mm_cmpeq_epi32(e, g);
+        auto ei = _mm_cmpeq_epi32(e, i);
+
+        /* (X and E != Y) or (Z and E != W) */
+        auto either = [](__m128i x, __m128i y, __m128i z, __m128i w) {
+          return _mm_or_si128(_mm_andnot_si128(y, x), _mm_andnot_si128(w, z));
+        };
+
+        Store3(&out0[x * 3], Select(db, d, e), Select(either(db, ec, bf, ea), b, e), Select(bf, f, e));
+        Store3(&out1[x * 3], Select(either(db, eg, dh, ea), d, e), e, Select(either(bf, ei, hf, ec), f, e));
+        Store3(&out2[x * 3], Select(dh, d, e), Select(either(dh, ei, hf, eg), h, e), Select(hf, f, e));
+      }
+#endif
+
+      for (; x < width; x++) {
+        Scale3xPixel(&above[x], &row[x], &below[x], &out0[x * 3], &out1[x * 3], &out2[x * 3]);
+      }
+    }
+  });
+}
+
+} // namespace common
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <common/thread_pool.hpp>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace common {
+
+/* Upscales frames of 32-bit pixels on the CPU, with the rows split across a thread pool.
+ * Pixels are only ever copied or compared for equality, so their channel order does not matter.
+ */
+class Scaler {
+public:
+  enum class Filter {
+    /// Repeats each pixel.
+    Nearest,
+    /// Scale2x/Scale3x (AdvMAME), which smoothens diagonal edges.
+    /// A factor of 4 applies Scale2x twice.
+    ScaleNx
+  };
+
+  /// The factor is clamped to the range 1 - 4.
+  Scaler(Filter filter, int factor, int threads);
+
+  auto Factor() const -> int { return factor; }
+
+  /// Scales a frame of width * height pixels into one of (width * factor) * (height * factor) pixels.
+  void Scale(std::uint32_t const* input, int width, int height, std::uint32_t* output);
+
+private:
+  /// Runs a task for each band of rows of the input, in parallel.
+  void ForEachBand(int height, std::function<void(int first, int last)> const& task);
+
+  void Nearest(std::uint32_t const* input, int width, int height, std::uint32_t* output);
+  void Scale2x(std::uint32_t const* input, int width, int height, std::uint32_t* output);
+  void Scale3x(std::uint32_t const* input, int width, int height, std::uint32_t* output);
+
+  Filter filter;
+  int factor;
+  ThreadPool pool;
+
+  /// Output of the first Scale2x pass at a factor of 4.
+  std::vector<std::uint32_t> intermediate;
+};
+
+} // namespace common
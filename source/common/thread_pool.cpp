@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <algorithm>
+
+#include "thread_pool.hpp"
+
+namespace common {
+
+ThreadPool::ThreadPool(int threads) {
+  for (int i = 1; i < std::max(threads, 1); i++) {
+    workers.emplace_back([this]() { Work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard guard{mutex};
+    running = false;
+  }
+  wake.notify_all();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+void ThreadPool::Run(int count, Task const& task) {
+  {
+    std::lock_guard guard{mutex};
+    this->task = &task;
+    task_count = count;
+    next_task = 0;
+    busy_workers = int(workers.size());
+    generation++;
+  }
+  wake.notify_all();
+
+  RunTasks();
+
+  // The task must stay alive until every worker has left it.
+  std::unique_lock lock{mutex};
+  done.wait(lock, [this]() { return busy_workers == 0; });
+  this->task = nullptr;
+}
+
+void ThreadPool::Work() {
+  std::uint64_t last_generation = 0;
+
+  while (true) {
+    {
+      std::unique_lock lock{mutex};
+
+      wake.wait(lock, [&]() { return generation != last_generation || !running; });
+      if (!running) {
+        return;
+      }
+      last_generation = generation;
+    }
+
+    RunTasks();
+
+    {
+      std::lock_guard guard{mutex};
+      busy_workers--;
+    }
+    done.notify_one();
+  }
+}
+
+void ThreadPool::RunTasks() {
+  int index;
+
+  while ((index = next_task.fetch_add(1)) < task_count) {
+    (*task)(index);
+  }
+}
+
+} // namespace common
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace common {
+
+/* Fixed set of worker threads for splitting a job into independent tasks.
+ * The calling thread takes part in the work, so a pool of n threads keeps n - 1 workers.
+ */
+class ThreadPool {
+public:
+  using Task = std::function<void(int index)>;
+
+  ThreadPool(int threads);
+ ~ThreadPool();
+
+  auto Size() const -> int { return int(workers.size()) + 1; }
+
+  /// Invokes task(0) to task(count - 1), distributed across the pool,
+  /// and returns once all of them completed.
+  void Run(int count, Task const& task);
+
+private:
+  void Work();
+  void RunTasks();
+
+  std::vector<std::thread> workers;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+
+  /// Bumped for every job, so that each worker joins a job only once.
+  std::uint64_t generation = 0;
+  bool running = true;
+
+  Task const* task = nullptr;
+  int task_count = 0;
+  std::atomic<int> next_task{0};
+  int busy_workers = 0;
+};
+
+} // namespace common
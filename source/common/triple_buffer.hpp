@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <atomic>
+
+namespace common {
+
+/* Lock-free handoff of buffers from a single producer to a single consumer.
+ * The producer writes to the back buffer and publishes it with one atomic exchange
+ * against the middle buffer. The consumer takes the latest published buffer the same way.
+ * Neither side ever waits, and neither ever touches a buffer while the other uses it.
+ */
+template<typename T>
+class TripleBuffer {
+public:
+  /// Returns the buffer owned by the producer.
+  auto Back() -> T& { return buffers[back]; }
+
+  /// Publishes the back buffer, returns the new back buffer.
+  /// The published buffer is left alone by the producer until the next call.
+  auto Publish() -> T& {
+    back = middle.exchange(back | s_fresh, std::memory_order_acq_rel) & s_index_mask;
+    return buffers[back];
+  }
+
+  /// Returns the most recently published buffer.
+  /// It is owned by the consumer, and remains valid until the next call.
+  auto Acquire() -> T const& {
+    if (middle.load(std::memory_order_relaxed) & s_fresh) {
+      front = middle.exchange(front, std::memory_order_acq_rel) & s_index_mask;
+    }
+    return buffers[front];
+  }
+
+private:
+  /* The middle index carries a flag, set while it holds a buffer the consumer has not taken yet. */
+  static constexpr int s_index_mask = 3;
+  static constexpr int s_fresh = 4;
+
+  T buffers[3] {};
+
+  int back = 0;
+  int front = 1;
+  std::atomic<int> middle{2};
+};
+
+} // namespace common
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <common/log.hpp>
+#include <cstring>
+#include <experimental/filesystem>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#if defined(WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#include "rom_cache.hpp"
+
+namespace nba {
+
+namespace fs = std::experimental::filesystem;
+
+#if defined(WIN32)
+
+static auto MapFile(std::string const& path, std::size_t size) -> std::shared_ptr<std::uint8_t[]> {
+  auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    return {};
+  }
+
+  auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+
+  if (mapping == nullptr) {
+    return {};
+  }
+
+  // The view keeps the file mapping alive, so the handle can be closed right away.
+  auto address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+  CloseHandle(mapping);
+
+  if (address == nullptr) {
+    return {};
+  }
+
+  return { static_cast<std::uint8_t*>(address), [](std::uint8_t* address) {
+    UnmapViewOfFile(address);
+  }};
+}
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+static auto MapFile(std::string const& path, std::size_t size) -> std::shared_ptr<std::uint8_t[]> {
+  int fd = open(path.c_str(), O_RDONLY);
+
+  if (fd == -1) {
+    return {};
+  }
+
+  /* The mapping keeps the file referenced, so the descriptor can be closed right away.
+   * Bytes past the end of the file up to the page boundary read as zero,
+   * but if the size is a multiple of the page size nothing past it may be read.
+   */
+  auto address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  if (address == MAP_FAILED) {
+    return {};
+  }
+
+  return { static_cast<std::uint8_t*>(address), [size](std::uint8_t* address) {
+    munmap(address, size);
+  }};
+}
+
+#else
+
+static auto MapFile(std::string const& path, std::size_t size) -> std::shared_ptr<std::uint8_t[]> {
+  std::ifstream stream { path, std::ios::binary };
+
+  if (!stream.good()) {
+    return {};
+  }
+
+  // Round up so that 16-bit and 32-bit reads of the last bytes stay in bounds.
+  std::shared_ptr<std::uint8_t[]> data { new std::uint8_t[(size + 3) & ~3]() };
+  stream.read((char*)data.get(), size);
+  return data;
+}
+
+#endif
+
+static auto HashContent(std::uint8_t const* data, std::size_t size) -> std::uint64_t {
+  std::uint64_t hash = 0xCBF29CE484222325;
+  std::size_t i = 0;
+
+  // FNV-1a, consuming eight bytes per step.
+  for (; i + 8 <= size; i += 8) {
+    std::uint64_t word;
+    std::memcpy(&word, &data[i], sizeof(word));
+    hash = (hash ^ word) * 0x100000001B3;
+  }
+
+  for (; i < size; i++) {
+    hash = (hash ^ data[i]) * 0x100000001B3;
+  }
+
+  return hash;
+}
+
+auto ROMCache::Load(std::string const& path) -> ROMImage {
+  struct FileState {
+    std::uintmax_t size;
+    fs::file_time_type time;
+    std::uint64_t hash;
+    std::weak_ptr<std::uint8_t[]> image;
+  };
+
+  static std::mutex mutex;
+
+  /// Image of each file, valid for as long as the file was not modified.
+  static std::map<std::string, FileState> files;
+
+  /// Live images by content hash and size, so that copies of a file are shared as well.
+  /// The hash only selects a candidate, the content is compared before an image is shared.
+  static std::map<std::pair<std::uint64_t, std::size_t>, std::weak_ptr<std::uint8_t[]>> images;
+
+  std::error_code error;
+  auto canonical_path = fs::canonical(path, error).string();
+  auto size = fs::file_size(canonical_path, error);
+  auto time = fs::last_write_time(canonical_path, error);
+
+  if (error) {
+    LOG_ERROR("ROMCache: unable to stat file: {0}", path);
+    return {};
+  }
+
+  std::lock_guard guard{mutex};
+
+  if (auto match = files.find(canonical_path); match != files.end()) {
+    auto& state = match->second;
+
+    if (state.size == size && state.time == time) {
+      if (auto data = state.image.lock()) {
+        return { data, size, state.hash };
+      }
+    }
+  }
+
+  auto data = MapFile(canonical_path, size);
+
+  if (!data) {
+    LOG_ERROR("ROMCache: unable to map file: {0}", path);
+    return {};
+  }
+
+  auto hash = HashContent(data.get(), size);
+  auto key = std::make_pair(hash, std::size_t(size));
+
+  // Another path may refer to a file with the same content.
+  if (auto match = images.find(key); match != images.end()) {
+    if (auto shared_data = match->second.lock()) {
+      if (std::memcmp(shared_data.get(), data.get(), size) == 0) {
+        files[canonical_path] = { size, time, hash, shared_data };
+        return { shared_data, size, hash };
+      }
+
+      // Hash collision, the image is not shared then.
+      files[canonical_path] = { size, time, hash, data };
+      return { data, size, hash };
+    }
+  }
+
+  // Drop the entries of images which are no longer used by any instance.
+  for (auto it = images.begin(); it != images.end();) {
+    it = it->second.expired() ? images.erase(it) : std::next(it);
+  }
+
+  for (auto it = files.begin(); it != files.end();) {
+    it = it->second.image.expired() ? files.erase(it) : std::next(it);
+  }
+
+  images[key] = data;
+  files[canonical_path] = { size, time, hash, data };
+  return { data, size, hash };
+}
+
+} // namespace nba
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace nba {
+
+/* Immutable ROM image, shared by all emulator instances which loaded the same game.
+ * The data is mapped read-only where the OS supports it, so it must never be written.
+ */
+struct ROMImage {
+  std::shared_ptr<std::uint8_t[]> data;
+  std::size_t size = 0;
+  std::uint64_t hash = 0;
+};
+
+/* Process-wide cache of ROM images, keyed by file path plus content hash.
+ * An image lives for as long as any emulator instance still references it.
+ */
+class ROMCache {
+public:
+  /// Returns the image of a ROM file, mapping the file only if it is not cached yet.
+  /// On failure an image without data is returned.
+  static auto Load(std::string const& path) -> ROMImage;
+};
+
+} // namespace nba
@@ -37,8 +37,28 @@ struct Config {
   bool force_rtc = false;
 
   struct Video {
+    enum class Renderer {
+      Software,
+      Vulkan,
+      Null
+    } renderer = Renderer::Vulkan;
+
+    PixelFormat pixel_format = PixelFormat::ARGB8888;
+    bool color_correction = false;
+
     bool fullscreen = false;
     int scale = 2;
+    enum class Scaler {
+      None,
+      Nearest,
+      ScaleNx
+    } scaler = Scaler::None;
+    int scaler_threads = 1;
+    bool render_thread = false;
+    int frame_threads = 0;
+    bool reuse_lines = false;
+    int frameskip = 0;
+    bool frameskip_auto = false;
     struct Shader {
       std::string path_vs = "";
       std::string path_fs = "";
@@ -57,6 +77,11 @@ struct Config {
     bool interpolate_fifo = true;
     bool m4a_xq_enable = false;
   } audio;
+
+  struct Memory {
+    bool huge_pages = true;
+    int numa_node = -1;
+  } memory;
   
   std::shared_ptr<AudioDevice> audio_dev = std::make_shared<NullAudioDevice>();
   std::shared_ptr<InputDevice> input_dev = std::make_shared<NullInputDevice>();
@@ -82,10 +82,71 @@ void config_toml_read(Config& config, std::string const& path) {
 
     if (video_result.is_ok()) {
       auto video = video_result.unwrap();
+      auto renderer = toml::find_or<std::string>(video, "renderer", "vulkan");
+
+      const std::map<std::string, Config::Video::Renderer> renderers{
+        { "software", Config::Video::Renderer::Software },
+        { "vulkan",   Config::Video::Renderer::Vulkan   },
+        { "null",     Config::Video::Renderer::Null     }
+      };
+
+      auto match = renderers.find(renderer);
+
+      if (match == renderers.end()) {
+        LOG_WARN("Renderer '{0}' is not valid, defaulting to Vulkan renderer.", renderer);
+        config.video.renderer = Config::Video::Renderer::Vulkan;
+      } else {
+        config.video.renderer = match->second;
+      }
+
+      auto pixel_format = toml::find_or<std::string>(video, "pixel_format", "argb8888");
+
+      const std::map<std::string, PixelFormat> pixel_formats{
+        { "bgr555",   PixelFormat::BGR555   },
+        { "rgb565",   PixelFormat::RGB565   },
+        { "argb8888", PixelFormat::ARGB8888 },
+        { "abgr8888", PixelFormat::ABGR8888 }
+      };
+
+      auto format_match = pixel_formats.find(pixel_format);
+
+      if (format_match == pixel_formats.end()) {
+        LOG_WARN("Pixel format '{0}' is not valid, defaulting to ARGB8888.", pixel_format);
+        config.video.pixel_format = PixelFormat::ARGB8888;
+      } else {
+        config.video.pixel_format = format_match->second;
+      }
+
+      config.video.color_correction = toml::find_or<toml::boolean>(video, "color_correction", false);
       config.video.fullscreen = toml::find_or<toml::boolean>(video, "fullscreen", false);
       config.video.scale = toml::find_or<int>(video, "scale", 2);
+
+      auto scaler = toml::find_or<std::string>(video, "scaler", "none");
+
+      const std::map<std::string, Config::Video::Scaler> scalers{
+        { "none",    Config::Video::Scaler::None    },
+        { "nearest", Config::Video::Scaler::Nearest },
+        { "scalenx", Config::Video::Scaler::ScaleNx }
+      };
+
+      auto scaler_match = scalers.find(scaler);
+
+      if (scaler_match == scalers.end()) {
+        LOG_WARN("Scaler '{0}' is not valid, defaulting to no scaler.", scaler);
+        config.video.scaler = Config::Video::Scaler::None;
+      } else {
+        config.video.scaler = scaler_match->second;
+      }
+
+      config.video.scaler_threads = toml::find_or<int>(video, "scaler_threads", 1);
+
       config.video.shader.path_vs = toml::find_or<std::string>(video, "shader_vs", "");
       config.video.shader.path_fs = toml::find_or<std::string>(video, "shader_fs", "");
+      config.video.render_thread = toml::find_or<toml::boolean>(video, "render_thread", false);
+      config.video.frame_threads = toml::find_or<int>(video, "frame_threads", 0);
+      config.video.reuse_lines = toml::find_or<toml::boolean>(video, "reuse_lines", false);
+      config.video.frameskip = toml::find_or<int>(video, "frameskip", 0);
+      config.video.frameskip_auto = toml::find_or<toml::boolean>(video, "frameskip_auto", false);
     }
   }
 
@@ -117,6 +178,16 @@ void config_toml_read(Config& config, std::string const& path) {
       config.audio.m4a_xq_enable = toml::find_or<toml::boolean>(audio, "m4a_xq_enable", false);
     }
   }
+
+  if (data.contains("memory")) {
+    auto memory_result = toml::expect<toml::value>(data.at("memory"));
+
+    if (memory_result.is_ok()) {
+      auto memory = memory_result.unwrap();
+      config.memory.huge_pages = toml::find_or<toml::boolean>(memory, "huge_pages", true);
+      config.memory.numa_node = toml::find_or<int>(memory, "numa_node", -1);
+    }
+  }
 }
 
 void config_toml_write(Config& config, std::string const& path) {
@@ -151,10 +222,42 @@ void config_toml_write(Config& config, std::string const& path) {
   data["cartridge"]["force_rtc"] = config.force_rtc;
 
   // Video
+  std::string renderer;
+  switch (config.video.renderer) {
+    case Config::Video::Renderer::Software: renderer = "software"; break;
+    case Config::Video::Renderer::Vulkan:   renderer = "vulkan"; break;
+    case Config::Video::Renderer::Null:     renderer = "null"; break;
+  }
+  data["video"]["renderer"] = renderer;
+
+  std::string pixel_format;
+  switch (config.video.pixel_format) {
+    case PixelFormat::BGR555:   pixel_format = "bgr555"; break;
+    case PixelFormat::RGB565:   pixel_format = "rgb565"; break;
+    case PixelFormat::ARGB8888: pixel_format = "argb8888"; break;
+    case PixelFormat::ABGR8888: pixel_format = "abgr8888"; break;
+  }
+  data["video"]["pixel_format"] = pixel_format;
+  data["video"]["color_correction"] = config.video.color_correction;
   data["video"]["fullscreen"] = config.video.fullscreen;
   data["video"]["scale"] = config.video.scale;
+
+  std::string scaler;
+  switch (config.video.scaler) {
+    case Config::Video::Scaler::None:    scaler = "none"; break;
+    case Config::Video::Scaler::Nearest: scaler = "nearest"; break;
+    case Config::Video::Scaler::ScaleNx: scaler = "scalenx"; break;
+  }
+  data["video"]["scaler"] = scaler;
+  data["video"]["scaler_threads"] = config.video.scaler_threads;
+
   data["video"]["shader_vs"] = config.video.shader.path_vs;
   data["video"]["shader_fs"] = config.video.shader.path_fs;
+  data["video"]["render_thread"] = config.video.render_thread;
+  data["video"]["frame_threads"] = config.video.frame_threads;
+  data["video"]["reuse_lines"] = config.video.reuse_lines;
+  data["video"]["frameskip"] = config.video.frameskip;
+  data["video"]["frameskip_auto"] = config.video.frameskip_auto;
 
   // Audio
   std::string resampler;
@@ -169,6 +272,10 @@ void config_toml_write(Config& config, std::string const& path) {
   data["audio"]["interpolate_fifo"] = config.audio.interpolate_fifo;
   data["audio"]["m4a_xq_enable"] = config.audio.m4a_xq_enable;
 
+  // Memory
+  data["memory"]["huge_pages"] = config.memory.huge_pages;
+  data["memory"]["numa_node"] = config.memory.numa_node;
+
   std::ofstream file{ path, std::ios::out };
   file << data;
   file.close();
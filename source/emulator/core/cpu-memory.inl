@@ -102,7 +102,7 @@ inline auto CPU::ReadByte(std::uint32_t address, Access access) -> std::uint8_t
   }
   case REGION_MMIO: {
     PrefetchStepRAM(cycles);
-    return ReadMMIO(address);
+    return ReadMMIO(address & ~1) >> ((address & 1) * 8);
   }
   case REGION_PRAM: {
     PrefetchStepRAM(cycles);
@@ -178,8 +178,7 @@ inline auto CPU::ReadHalf(std::uint32_t address, Access access) -> std::uint16_t
   }
   case REGION_MMIO: {
     PrefetchStepRAM(cycles);
-    return  ReadMMIO(address + 0) |
-           (ReadMMIO(address + 1) << 8);
+    return ReadMMIO(address);
   }
   case REGION_PRAM: {
     PrefetchStepRAM(cycles);
@@ -267,10 +266,8 @@ inline auto CPU::ReadWord(std::uint32_t address, Access access) -> std::uint32_t
   }
   case REGION_MMIO: {
     PrefetchStepRAM(cycles);
-    return ReadMMIO(address + 0) |
-          (ReadMMIO(address + 1) << 8 ) |
-          (ReadMMIO(address + 2) << 16) |
-          (ReadMMIO(address + 3) << 24);
+    return  ReadMMIO(address + 0) |
+           (ReadMMIO(address + 2) << 16);
   }
   case REGION_PRAM: {
     PrefetchStepRAM(cycles);
@@ -341,14 +338,15 @@ inline void CPU::WriteByte(std::uint32_t address, std::uint8_t value, Access acc
   }
   case REGION_MMIO: {
     PrefetchStepRAM(cycles);
-    WriteMMIO(address, value & 0xFF);
+    int shift = (address & 1) * 8;
+    WriteMMIO(address & ~1, value << shift, 0xFF << shift);
     break;
   }
   case REGION_PRAM: {
     PrefetchStepRAM(cycles);
     address &= 0x3FE;
     Write<std::uint16_t>(ppu->pram, address, value * 0x0101);
-    ppu->HookPRAM(address, sizeof(std::uint16_t));
+    HookPRAM(address, sizeof(std::uint16_t));
     break;
   }
   case REGION_VRAM: {
@@ -362,7 +360,7 @@ inline void CPU::WriteByte(std::uint32_t address, std::uint8_t value, Access acc
     if (address < limit) {
       address &= ~1;
       Write<std::uint16_t>(ppu->vram, address, value * 0x0101);
-      ppu->HookVRAM(address, sizeof(std::uint16_t));
+      HookVRAM(address, sizeof(std::uint16_t));
     }
     break;
   }
@@ -402,15 +400,14 @@ inline void CPU::WriteHalf(std::uint32_t address, std::uint16_t value, Access ac
   }
   case REGION_MMIO: {
     PrefetchStepRAM(cycles);
-    WriteMMIO(address + 0, (value >> 0) & 0xFF);
-    WriteMMIO(address + 1, (value >> 8) & 0xFF);
+    WriteMMIO(address, value, 0xFFFF);
     break;
   }
   case REGION_PRAM: {
     PrefetchStepRAM(cycles);
     address &= 0x3FF;
     Write<std::uint16_t>(ppu->pram, address, value);
-    ppu->HookPRAM(address, sizeof(std::uint16_t));
+    HookPRAM(address, sizeof(std::uint16_t));
     break;
   }
   case REGION_VRAM: {
@@ -420,14 +417,14 @@ inline void CPU::WriteHalf(std::uint32_t address, std::uint16_t value, Access ac
       address &= ~0x8000;
     }
     Write<std::uint16_t>(ppu->vram, address, value);
-    ppu->HookVRAM(address, sizeof(std::uint16_t));
+    HookVRAM(address, sizeof(std::uint16_t));
     break;
   }
   case REGION_OAM: {
     PrefetchStepRAM(cycles);
     address &= 0x3FF;
     Write<std::uint16_t>(ppu->oam, address, value);
-    ppu->HookOAM(address, sizeof(std::uint16_t));
+    HookOAM(address, sizeof(std::uint16_t));
     break;
   }
   case REGION_ROM_W0_L: case REGION_ROM_W0_H:
@@ -494,17 +491,15 @@ inline void CPU::WriteWord(std::uint32_t address, std::uint32_t value, Access ac
   }
   case REGION_MMIO: {
     PrefetchStepRAM(cycles);
-    WriteMMIO(address + 0, (value >>  0) & 0xFF);
-    WriteMMIO(address + 1, (value >>  8) & 0xFF);
-    WriteMMIO(address + 2, (value >> 16) & 0xFF);
-    WriteMMIO(address + 3, (value >> 24) & 0xFF);
+    WriteMMIO(address + 0, value & 0xFFFF, 0xFFFF);
+    WriteMMIO(address + 2, value >> 16, 0xFFFF);
     break;
   }
   case REGION_PRAM: {
     PrefetchStepRAM(cycles);
     address &= 0x3FF;
     Write<std::uint32_t>(ppu->pram, address, value);
-    ppu->HookPRAM(address, sizeof(std::uint32_t));
+    HookPRAM(address, sizeof(std::uint32_t));
     break;
   }
   case REGION_VRAM: {
@@ -514,14 +509,14 @@ inline void CPU::WriteWord(std::uint32_t address, std::uint32_t value, Access ac
       address &= ~0x8000;
     }
     Write<std::uint32_t>(ppu->vram, address, value);
-    ppu->HookVRAM(address, sizeof(std::uint32_t));
+    HookVRAM(address, sizeof(std::uint32_t));
     break;
   }
   case REGION_OAM: {
     PrefetchStepRAM(cycles);
     address &= 0x3FF;
     Write<std::uint32_t>(ppu->oam, address, value);
-    ppu->HookOAM(address, sizeof(std::uint32_t));
+    HookOAM(address, sizeof(std::uint32_t));
     break;
   }
   case REGION_ROM_W0_L: case REGION_ROM_W0_H:
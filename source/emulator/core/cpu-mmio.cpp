@@ -10,565 +10,482 @@
 
 namespace nba::core {
 
+using ReadFn  = decltype(MMIORegister::read);
+using WriteFn = decltype(MMIORegister::write);
 
-auto CPU::ReadMMIO(std::uint32_t address) -> std::uint8_t {
-  auto& apu_io = apu.mmio;
-  auto& ppu_io = ppu->mmio;
-
-  switch (address) {
-    /* PPU */
-    case DISPCNT+0:  return ppu_io.dispcnt.Read(0);
-    case DISPCNT+1:  return ppu_io.dispcnt.Read(1);
-    case DISPSTAT+0: return ppu_io.dispstat.Read(0);
-    case DISPSTAT+1: return ppu_io.dispstat.Read(1);
-    case VCOUNT+0:   return ppu_io.vcount & 0xFF;
-    case VCOUNT+1:   return 0;
-    case BG0CNT+0:   return ppu_io.bgcnt[0].Read(0);
-    case BG0CNT+1:   return ppu_io.bgcnt[0].Read(1);
-    case BG1CNT+0:   return ppu_io.bgcnt[1].Read(0);
-    case BG1CNT+1:   return ppu_io.bgcnt[1].Read(1);
-    case BG2CNT+0:   return ppu_io.bgcnt[2].Read(0);
-    case BG2CNT+1:   return ppu_io.bgcnt[2].Read(1);
-    case BG3CNT+0:   return ppu_io.bgcnt[3].Read(0);
-    case BG3CNT+1:   return ppu_io.bgcnt[3].Read(1);
-    case WININ+0:    return ppu_io.winin.Read(0);
-    case WININ+1:    return ppu_io.winin.Read(1);
-    case WINOUT+0:   return ppu_io.winout.Read(0);
-    case WINOUT+1:   return ppu_io.winout.Read(1);
-    case BLDCNT+0:   return ppu_io.bldcnt.Read(0);
-    case BLDCNT+1:   return ppu_io.bldcnt.Read(1);
-    case BLDALPHA+0: return ppu_io.eva;
-    case BLDALPHA+1: return ppu_io.evb;
-
-    /* DMAs 0-3 */
-    case DMA0CNT_L:
-    case DMA0CNT_L+1: return 0;
-    case DMA0CNT_H:   return dma.Read(0, 10);
-    case DMA0CNT_H+1: return dma.Read(0, 11);
-    case DMA1CNT_L:
-    case DMA1CNT_L+1: return 0;
-    case DMA1CNT_H:   return dma.Read(1, 10);
-    case DMA1CNT_H+1: return dma.Read(1, 11);
-    case DMA2CNT_L:
-    case DMA2CNT_L+1: return 0;
-    case DMA2CNT_H:   return dma.Read(2, 10);
-    case DMA2CNT_H+1: return dma.Read(2, 11);
-    case DMA3CNT_L:
-    case DMA3CNT_L+1: return 0;
-    case DMA3CNT_H:   return dma.Read(3, 10);
-    case DMA3CNT_H+1: return dma.Read(3, 11);
-
-    /* SOUND */
-    case SOUND1CNT_L:   return apu.psg1.Read(0);
-    case SOUND1CNT_L+1: return apu.psg1.Read(1);
-    case SOUND1CNT_H:   return apu.psg1.Read(2);
-    case SOUND1CNT_H+1: return apu.psg1.Read(3);
-    case SOUND1CNT_X:   return apu.psg1.Read(4);
-    case SOUND1CNT_X+1: return apu.psg1.Read(5);
-    case SOUND1CNT_X+2:
-    case SOUND1CNT_X+3: return 0;
-    case SOUND2CNT_L:   return apu.psg2.Read(2);
-    case SOUND2CNT_L+1: return apu.psg2.Read(3);
-    case SOUND2CNT_H:   return apu.psg2.Read(4);
-    case SOUND2CNT_H+1: return apu.psg2.Read(5);
-    case SOUND2CNT_H+2:
-    case SOUND2CNT_H+3: return 0;
-    case SOUND3CNT_L:   return apu.psg3.Read(0);
-    case SOUND3CNT_L+1: return apu.psg3.Read(1);
-    case SOUND3CNT_H:   return apu.psg3.Read(2);
-    case SOUND3CNT_H+1: return apu.psg3.Read(3);
-    case SOUND3CNT_X:   return apu.psg3.Read(4);
-    case SOUND3CNT_X+1: return apu.psg3.Read(5);
-    case SOUND3CNT_X+2:
-    case SOUND3CNT_X+3: return 0;
-    case SOUND4CNT_L:   return apu.psg4.Read(0);
-    case SOUND4CNT_L+1: return apu.psg4.Read(1);
-    case SOUND4CNT_L+2:
-    case SOUND4CNT_L+3: return 0;
-    case SOUND4CNT_H:   return apu.psg4.Read(4);
-    case SOUND4CNT_H+1: return apu.psg4.Read(5);
-    case SOUND4CNT_H+2:
-    case SOUND4CNT_H+3: return 0;
-    case WAVE_RAM + 0:
-    case WAVE_RAM + 1:
-    case WAVE_RAM + 2:
-    case WAVE_RAM + 3:
-    case WAVE_RAM + 4:
-    case WAVE_RAM + 5:
-    case WAVE_RAM + 6:
-    case WAVE_RAM + 7:
-    case WAVE_RAM + 8:
-    case WAVE_RAM + 9:
-    case WAVE_RAM + 10:
-    case WAVE_RAM + 11:
-    case WAVE_RAM + 12:
-    case WAVE_RAM + 13:
-    case WAVE_RAM + 14:
-    case WAVE_RAM + 15: {
-      return apu.psg3.ReadSample(address & 0xF);
-    }
-    case SOUNDCNT_L:   return apu_io.soundcnt.Read(0);
-    case SOUNDCNT_L+1: return apu_io.soundcnt.Read(1);
-    case SOUNDCNT_H:   return apu_io.soundcnt.Read(2);
-    case SOUNDCNT_H+1: return apu_io.soundcnt.Read(3);
-    case SOUNDCNT_X:   return apu_io.soundcnt.Read(4);
-    case SOUNDCNT_X+1:
-    case SOUNDCNT_X+2:
-    case SOUNDCNT_X+3: return 0;
-    case SOUNDBIAS:   return apu_io.bias.Read(0);
-    case SOUNDBIAS+1: return apu_io.bias.Read(1);
-    case SOUNDBIAS+2:
-    case SOUNDBIAS+3: return 0;
-
-    /* Timers 0-3 */
-    case TM0CNT_L:   return timer.Read(0, 0);
-    case TM0CNT_L+1: return timer.Read(0, 1);
-    case TM0CNT_H:   return timer.Read(0, 2);
-    case TM0CNT_H+1: return 0;
-    case TM1CNT_L:   return timer.Read(1, 0);
-    case TM1CNT_L+1: return timer.Read(1, 1);
-    case TM1CNT_H:   return timer.Read(1, 2);
-    case TM1CNT_H+1: return 0;
-    case TM2CNT_L:   return timer.Read(2, 0);
-    case TM2CNT_L+1: return timer.Read(2, 1);
-    case TM2CNT_H:   return timer.Read(2, 2);
-    case TM2CNT_H+1: return 0;
-    case TM3CNT_L:   return timer.Read(3, 0);
-    case TM3CNT_L+1: return timer.Read(3, 1);
-    case TM3CNT_H:   return timer.Read(3, 2);
-    case TM3CNT_H+1: return 0;
-
-    /* Serial Communication (1, 2) */
-    case SIOMULTI0 | 0:
-    case SIOMULTI0 | 1:
-    case SIOMULTI1 | 0:
-    case SIOMULTI1 | 1:
-    case SIOMULTI2 | 0:
-    case SIOMULTI2 | 1:
-    case SIOMULTI3 | 0:
-    case SIOMULTI3 | 1:
-    case SIOCNT | 0:
-    case SIOCNT | 1:
-    case SIOMLT_SEND | 0:
-    case SIOMLT_SEND | 1:
-    case RCNT | 0:
-    case RCNT | 1:
-    case RCNT | 2:
-    case RCNT | 3:
-    case JOYCNT | 0:
-    case JOYCNT | 1:
-    case JOYCNT | 2:
-    case JOYCNT | 3:
-    case JOY_RECV | 0:
-    case JOY_RECV | 1:
-    case JOY_RECV | 2:
-    case JOY_RECV | 3:
-    case JOY_TRANS | 0:
-    case JOY_TRANS | 1:
-    case JOY_TRANS | 2:
-    case JOY_TRANS | 3:
-    case JOYSTAT | 0:
-    case JOYSTAT | 1:
-    case JOYSTAT | 2:
-    case JOYSTAT | 3:
-      return serial_bus.Read(address);
-
-    case KEYINPUT+0: {
-      return mmio.keyinput & 0x00FF;
-    }
-    case KEYINPUT+1: {
-      return (mmio.keyinput & 0xFF00) >> 8;
-    }
+/* Adapters for registers whose state is still accessed one byte at a time. */
+template <typename T>
+static auto ReadLanes(T& reg, int offset) -> std::uint16_t {
+  return reg.Read(offset + 0) | (reg.Read(offset + 1) << 8);
+}
 
-    case KEYCNT: {
-      return mmio.keycnt.input_mask & 0x00FF;
-    }
-    case KEYCNT+1: {
-      return ((mmio.keycnt.input_mask >> 8) & 3) |
-             (mmio.keycnt.interrupt << 6) |
-             (mmio.keycnt.and_mode << 7);
-    }
+template <typename T>
+static void WriteLanes(T& reg, int offset, std::uint16_t value, std::uint16_t mask) {
+  if (mask & 0x00FF) {
+    reg.Write(offset + 0, value & 0xFF);
+  }
+  if (mask & 0xFF00) {
+    reg.Write(offset + 1, value >> 8);
+  }
+}
 
-    /* Interrupt Control */
-    case IE+0:  return irq_controller.Read(0);
-    case IE+1:  return irq_controller.Read(1);
-    case IF+0:  return irq_controller.Read(2);
-    case IF+1:  return irq_controller.Read(3);
-    case IME+0: return irq_controller.Read(4);
-    case IME+1:
-    case IME+2:
-    case IME+3: return 0;
-
-    /* Waitstates */
-    case WAITCNT+0: {
-      return mmio.waitcnt.sram |
-             (mmio.waitcnt.ws0_n << 2) |
-             (mmio.waitcnt.ws0_s << 4) |
-             (mmio.waitcnt.ws1_n << 5) |
-             (mmio.waitcnt.ws1_s << 7);
-    }
-    case WAITCNT+1: {
-      return mmio.waitcnt.ws2_n |
-             (mmio.waitcnt.ws2_s << 2) |
-             (mmio.waitcnt.phi << 3) |
-             (mmio.waitcnt.prefetch << 6);
-    }
-    case WAITCNT+2:
-    case WAITCNT+3: return 0;
-    case POSTFLG: return mmio.postflg;
+const MMIOTable CPU::s_mmio_table = CPU::CreateMMIOTable();
+
+auto CPU::CreateMMIOTable() -> MMIOTable {
+  MMIOTable table;
+
+  ReadFn read_unused = [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+    return cpu.ReadUnused(address);
+  };
+
+  ReadFn read_zero = [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+    return 0;
+  };
+
+  for (auto& entry : table.registers) {
+    entry.read  = read_unused;
+    entry.write = [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {};
   }
 
-  return ReadUnused(address);
-}
+  // Write-only registers pass a nullptr read handler and vice versa.
+  auto map = [&](std::uint32_t address, ReadFn read, WriteFn write) {
+    auto& entry = table.registers[(address & 0x3FF) >> 1];
 
-void CPU::WriteMMIO(std::uint32_t address, std::uint8_t value) {
-  auto& apu_io = apu.mmio;
-  auto& ppu_io = ppu->mmio;
-
-  switch (address) {
-    /* PPU */
-    case DISPCNT+0:  ppu_io.dispcnt.Write(0, value); break;
-    case DISPCNT+1:  ppu_io.dispcnt.Write(1, value); break;
-    case DISPSTAT+0: ppu_io.dispstat.Write(0, value); break;
-    case DISPSTAT+1: ppu_io.dispstat.Write(1, value); break;
-    case BG0CNT+0:   ppu_io.bgcnt[0].Write(0, value); break;
-    case BG0CNT+1:   ppu_io.bgcnt[0].Write(1, value); break;
-    case BG1CNT+0:   ppu_io.bgcnt[1].Write(0, value); break;
-    case BG1CNT+1:   ppu_io.bgcnt[1].Write(1, value); break;
-    case BG2CNT+0:   ppu_io.bgcnt[2].Write(0, value); break;
-    case BG2CNT+1:   ppu_io.bgcnt[2].Write(1, value); break;
-    case BG3CNT+0:   ppu_io.bgcnt[3].Write(0, value); break;
-    case BG3CNT+1:   ppu_io.bgcnt[3].Write(1, value); break;
-    case BG0HOFS+0:
-      ppu_io.bghofs[0] &= 0xFF00;
-      ppu_io.bghofs[0] |= value;
-      break;
-    case BG0HOFS+1:
-      ppu_io.bghofs[0] &= 0x00FF;
-      ppu_io.bghofs[0] |= (value & 1) << 8;
-      break;
-    case BG0VOFS+0:
-      ppu_io.bgvofs[0] &= 0xFF00;
-      ppu_io.bgvofs[0] |= value;
-      break;
-    case BG0VOFS+1:
-      ppu_io.bgvofs[0] &= 0x00FF;
-      ppu_io.bgvofs[0] |= (value & 1) << 8;
-      break;
-    case BG1HOFS+0:
-      ppu_io.bghofs[1] &= 0xFF00;
-      ppu_io.bghofs[1] |= value;
-      break;
-    case BG1HOFS+1:
-      ppu_io.bghofs[1] &= 0x00FF;
-      ppu_io.bghofs[1] |= (value & 1) << 8;
-      break;
-    case BG1VOFS+0:
-      ppu_io.bgvofs[1] &= 0xFF00;
-      ppu_io.bgvofs[1] |= value;
-      break;
-    case BG1VOFS+1:
-      ppu_io.bgvofs[1] &= 0x00FF;
-      ppu_io.bgvofs[1] |= (value & 1) << 8;
-      break;
-    case BG2HOFS+0:
-      ppu_io.bghofs[2] &= 0xFF00;
-      ppu_io.bghofs[2] |= value;
-      break;
-    case BG2HOFS+1:
-      ppu_io.bghofs[2] &= 0x00FF;
-      ppu_io.bghofs[2] |= (value & 1) << 8;
-      break;
-    case BG2VOFS+0:
-      ppu_io.bgvofs[2] &= 0xFF00;
-      ppu_io.bgvofs[2] |= value;
-      break;
-    case BG2VOFS+1:
-      ppu_io.bgvofs[2] &= 0x00FF;
-      ppu_io.bgvofs[2] |= (value & 1) << 8;
-      break;
-    case BG3HOFS+0:
-      ppu_io.bghofs[3] &= 0xFF00;
-      ppu_io.bghofs[3] |= value;
-      break;
-    case BG3HOFS+1:
-      ppu_io.bghofs[3] &= 0x00FF;
-      ppu_io.bghofs[3] |= (value & 1) << 8;
-      break;
-    case BG3VOFS+0:
-      ppu_io.bgvofs[3] &= 0xFF00;
-      ppu_io.bgvofs[3] |= value;
-      break;
-    case BG3VOFS+1:
-      ppu_io.bgvofs[3] &= 0x00FF;
-      ppu_io.bgvofs[3] |= (value & 1) << 8;
-      break;
-
-    case BG2PA:   ppu_io.bgpa[0] = (ppu_io.bgpa[0] & 0xFF00) | (value << 0); break;
-    case BG2PA+1: ppu_io.bgpa[0] = (ppu_io.bgpa[0] & 0x00FF) | (value << 8); break;
-    case BG2PB:   ppu_io.bgpb[0] = (ppu_io.bgpb[0] & 0xFF00) | (value << 0); break;
-    case BG2PB+1: ppu_io.bgpb[0] = (ppu_io.bgpb[0] & 0x00FF) | (value << 8); break;
-    case BG2PC:   ppu_io.bgpc[0] = (ppu_io.bgpc[0] & 0xFF00) | (value << 0); break;
-    case BG2PC+1: ppu_io.bgpc[0] = (ppu_io.bgpc[0] & 0x00FF) | (value << 8); break;
-    case BG2PD:   ppu_io.bgpd[0] = (ppu_io.bgpd[0] & 0xFF00) | (value << 0); break;
-    case BG2PD+1: ppu_io.bgpd[0] = (ppu_io.bgpd[0] & 0x00FF) | (value << 8); break;
-    case BG2X:    ppu_io.bgx[0].Write(0, value); break;
-    case BG2X+1:  ppu_io.bgx[0].Write(1, value); break;
-    case BG2X+2:  ppu_io.bgx[0].Write(2, value); break;
-    case BG2X+3:  ppu_io.bgx[0].Write(3, value); break;
-    case BG2Y:    ppu_io.bgy[0].Write(0, value); break;
-    case BG2Y+1:  ppu_io.bgy[0].Write(1, value); break;
-    case BG2Y+2:  ppu_io.bgy[0].Write(2, value); break;
-    case BG2Y+3:  ppu_io.bgy[0].Write(3, value); break;
-    case BG3PA:   ppu_io.bgpa[1] = (ppu_io.bgpa[1] & 0xFF00) | (value << 0); break;
-    case BG3PA+1: ppu_io.bgpa[1] = (ppu_io.bgpa[1] & 0x00FF) | (value << 8); break;
-    case BG3PB:   ppu_io.bgpb[1] = (ppu_io.bgpb[1] & 0xFF00) | (value << 0); break;
-    case BG3PB+1: ppu_io.bgpb[1] = (ppu_io.bgpb[1] & 0x00FF) | (value << 8); break;
-    case BG3PC:   ppu_io.bgpc[1] = (ppu_io.bgpc[1] & 0xFF00) | (value << 0); break;
-    case BG3PC+1: ppu_io.bgpc[1] = (ppu_io.bgpc[1] & 0x00FF) | (value << 8); break;
-    case BG3PD:   ppu_io.bgpd[1] = (ppu_io.bgpd[1] & 0xFF00) | (value << 0); break;
-    case BG3PD+1: ppu_io.bgpd[1] = (ppu_io.bgpd[1] & 0x00FF) | (value << 8); break;
-    case BG3X:    ppu_io.bgx[1].Write(0, value); break;
-    case BG3X+1:  ppu_io.bgx[1].Write(1, value); break;
-    case BG3X+2:  ppu_io.bgx[1].Write(2, value); break;
-    case BG3X+3:  ppu_io.bgx[1].Write(3, value); break;
-    case BG3Y:    ppu_io.bgy[1].Write(0, value); break;
-    case BG3Y+1:  ppu_io.bgy[1].Write(1, value); break;
-    case BG3Y+2:  ppu_io.bgy[1].Write(2, value); break;
-    case BG3Y+3:  ppu_io.bgy[1].Write(3, value); break;
-
-    case WIN0H+0: ppu_io.winh[0].Write(0, value); break;
-    case WIN0H+1: ppu_io.winh[0].Write(1, value); break;
-    case WIN1H+0: ppu_io.winh[1].Write(0, value); break;
-    case WIN1H+1: ppu_io.winh[1].Write(1, value); break;
-    case WIN0V+0: ppu_io.winv[0].Write(0, value); break;
-    case WIN0V+1: ppu_io.winv[0].Write(1, value); break;
-    case WIN1V+0: ppu_io.winv[1].Write(0, value); break;
-    case WIN1V+1: ppu_io.winv[1].Write(1, value); break;
-    case WININ+0: ppu_io.winin.Write(0, value); break;
-    case WININ+1: ppu_io.winin.Write(1, value); break;
-    case WINOUT+0: ppu_io.winout.Write(0, value); break;
-    case WINOUT+1: ppu_io.winout.Write(1, value); break;
-    case MOSAIC+0: ppu_io.mosaic.Write(0, value); break;
-    case MOSAIC+1: ppu_io.mosaic.Write(1, value); break;
-    case BLDCNT+0: ppu_io.bldcnt.Write(0, value); break;
-    case BLDCNT+1: ppu_io.bldcnt.Write(1, value); break;
-    case BLDALPHA+0: ppu_io.eva = value & 0x1F; break;
-    case BLDALPHA+1: ppu_io.evb = value & 0x1F; break;
-    case BLDY: ppu_io.evy = value & 0x1F; break;
-
-    /* DMAs 0-3 */
-    case DMA0SAD:     dma.Write(0, 0, value); break;
-    case DMA0SAD+1:   dma.Write(0, 1, value); break;
-    case DMA0SAD+2:   dma.Write(0, 2, value); break;
-    case DMA0SAD+3:   dma.Write(0, 3, value); break;
-    case DMA0DAD:     dma.Write(0, 4, value); break;
-    case DMA0DAD+1:   dma.Write(0, 5, value); break;
-    case DMA0DAD+2:   dma.Write(0, 6, value); break;
-    case DMA0DAD+3:   dma.Write(0, 7, value); break;
-    case DMA0CNT_L:   dma.Write(0, 8, value); break;
-    case DMA0CNT_L+1: dma.Write(0, 9, value); break;
-    case DMA0CNT_H:   dma.Write(0, 10, value); break;
-    case DMA0CNT_H+1: dma.Write(0, 11, value); break;
-    case DMA1SAD:     dma.Write(1, 0, value); break;
-    case DMA1SAD+1:   dma.Write(1, 1, value); break;
-    case DMA1SAD+2:   dma.Write(1, 2, value); break;
-    case DMA1SAD+3:   dma.Write(1, 3, value); break;
-    case DMA1DAD:     dma.Write(1, 4, value); break;
-    case DMA1DAD+1:   dma.Write(1, 5, value); break;
-    case DMA1DAD+2:   dma.Write(1, 6, value); break;
-    case DMA1DAD+3:   dma.Write(1, 7, value); break;
-    case DMA1CNT_L:   dma.Write(1, 8, value); break;
-    case DMA1CNT_L+1: dma.Write(1, 9, value); break;
-    case DMA1CNT_H:   dma.Write(1, 10, value); break;
-    case DMA1CNT_H+1: dma.Write(1, 11, value); break;
-    case DMA2SAD:     dma.Write(2, 0, value); break;
-    case DMA2SAD+1:   dma.Write(2, 1, value); break;
-    case DMA2SAD+2:   dma.Write(2, 2, value); break;
-    case DMA2SAD+3:   dma.Write(2, 3, value); break;
-    case DMA2DAD:     dma.Write(2, 4, value); break;
-    case DMA2DAD+1:   dma.Write(2, 5, value); break;
-    case DMA2DAD+2:   dma.Write(2, 6, value); break;
-    case DMA2DAD+3:   dma.Write(2, 7, value); break;
-    case DMA2CNT_L:   dma.Write(2, 8, value); break;
-    case DMA2CNT_L+1: dma.Write(2, 9, value); break;
-    case DMA2CNT_H:   dma.Write(2, 10, value); break;
-    case DMA2CNT_H+1: dma.Write(2, 11, value); break;
-    case DMA3SAD:     dma.Write(3, 0, value); break;
-    case DMA3SAD+1:   dma.Write(3, 1, value); break;
-    case DMA3SAD+2:   dma.Write(3, 2, value); break;
-    case DMA3SAD+3:   dma.Write(3, 3, value); break;
-    case DMA3DAD:     dma.Write(3, 4, value); break;
-    case DMA3DAD+1:   dma.Write(3, 5, value); break;
-    case DMA3DAD+2:   dma.Write(3, 6, value); break;
-    case DMA3DAD+3:   dma.Write(3, 7, value); break;
-    case DMA3CNT_L:   dma.Write(3, 8, value); break;
-    case DMA3CNT_L+1: dma.Write(3, 9, value); break;
-    case DMA3CNT_H:   dma.Write(3, 10, value); break;
-    case DMA3CNT_H+1: dma.Write(3, 11, value); break;
-
-    /* SOUND */
-    case SOUND1CNT_L:   apu.psg1.Write(0, value); break;
-    case SOUND1CNT_L+1: apu.psg1.Write(1, value); break;
-    case SOUND1CNT_H:   apu.psg1.Write(2, value); break;
-    case SOUND1CNT_H+1: apu.psg1.Write(3, value); break;
-    case SOUND1CNT_X:   apu.psg1.Write(4, value); break;
-    case SOUND1CNT_X+1: apu.psg1.Write(5, value); break;
-    case SOUND2CNT_L:   apu.psg2.Write(2, value); break;
-    case SOUND2CNT_L+1: apu.psg2.Write(3, value); break;
-    case SOUND2CNT_H:   apu.psg2.Write(4, value); break;
-    case SOUND2CNT_H+1: apu.psg2.Write(5, value); break;
-    case SOUND3CNT_L:   apu.psg3.Write(0, value); break;
-    case SOUND3CNT_L+1: apu.psg3.Write(1, value); break;
-    case SOUND3CNT_H:   apu.psg3.Write(2, value); break;
-    case SOUND3CNT_H+1: apu.psg3.Write(3, value); break;
-    case SOUND3CNT_X:   apu.psg3.Write(4, value); break;
-    case SOUND3CNT_X+1: apu.psg3.Write(5, value); break;
-    case SOUND4CNT_L:   apu.psg4.Write(0, value); break;
-    case SOUND4CNT_L+1: apu.psg4.Write(1, value); break;
-    case SOUND4CNT_H:   apu.psg4.Write(4, value); break;
-    case SOUND4CNT_H+1: apu.psg4.Write(5, value); break;
-    case WAVE_RAM+0:
-    case WAVE_RAM+1:
-    case WAVE_RAM+2:
-    case WAVE_RAM+3:
-    case WAVE_RAM+4:
-    case WAVE_RAM+5:
-    case WAVE_RAM+6:
-    case WAVE_RAM+7:
-    case WAVE_RAM+8:
-    case WAVE_RAM+9:
-    case WAVE_RAM+10:
-    case WAVE_RAM+11:
-    case WAVE_RAM+12:
-    case WAVE_RAM+13:
-    case WAVE_RAM+14:
-    case WAVE_RAM+15: {
-      apu.psg3.WriteSample(address & 0xF, value);
-      break;
+    if (read != nullptr) {
+      entry.read = read;
     }
-    case FIFO_A:
-    case FIFO_A+1:
-    case FIFO_A+2:
-    case FIFO_A+3: apu_io.fifo[0].Write(value); break;
-    case FIFO_B:
-    case FIFO_B+1:
-    case FIFO_B+2:
-    case FIFO_B+3: apu_io.fifo[1].Write(value); break;
-    case SOUNDCNT_L:   apu_io.soundcnt.Write(0, value); break;
-    case SOUNDCNT_L+1: apu_io.soundcnt.Write(1, value); break;
-    case SOUNDCNT_H:   apu_io.soundcnt.Write(2, value); break;
-    case SOUNDCNT_H+1: apu_io.soundcnt.Write(3, value); break;
-    case SOUNDCNT_X:   apu_io.soundcnt.Write(4, value); break;
-    case SOUNDBIAS:    apu_io.bias.Write(0, value); break;
-    case SOUNDBIAS+1:  apu_io.bias.Write(1, value); break;
-
-    /* Timers 0-3 */
-    case TM0CNT_L:   timer.Write(0, 0, value); break;
-    case TM0CNT_L+1: timer.Write(0, 1, value); break;
-    case TM0CNT_H:   timer.Write(0, 2, value); break;
-    case TM1CNT_L:   timer.Write(1, 0, value); break;
-    case TM1CNT_L+1: timer.Write(1, 1, value); break;
-    case TM1CNT_H:   timer.Write(1, 2, value); break;
-    case TM2CNT_L:   timer.Write(2, 0, value); break;
-    case TM2CNT_L+1: timer.Write(2, 1, value); break;
-    case TM2CNT_H:   timer.Write(2, 2, value); break;
-    case TM3CNT_L:   timer.Write(3, 0, value); break;
-    case TM3CNT_L+1: timer.Write(3, 1, value); break;
-    case TM3CNT_H:   timer.Write(3, 2, value); break;
-
-    /* Serial Communication (1, 2) */
-    case SIOMULTI0 | 0:
-    case SIOMULTI0 | 1:
-    case SIOMULTI1 | 0:
-    case SIOMULTI1 | 1:
-    case SIOMULTI2 | 0:
-    case SIOMULTI2 | 1:
-    case SIOMULTI3 | 0:
-    case SIOMULTI3 | 1:
-    case SIOCNT | 0:
-    case SIOCNT | 1:
-    case SIOMLT_SEND | 0:
-    case SIOMLT_SEND | 1:
-    case RCNT | 0:
-    case RCNT | 1:
-    case RCNT | 2:
-    case RCNT | 3:
-    case JOYCNT | 0:
-    case JOYCNT | 1:
-    case JOYCNT | 2:
-    case JOYCNT | 3:
-    case JOY_RECV | 0:
-    case JOY_RECV | 1:
-    case JOY_RECV | 2:
-    case JOY_RECV | 3:
-    case JOY_TRANS | 0:
-    case JOY_TRANS | 1:
-    case JOY_TRANS | 2:
-    case JOY_TRANS | 3:
-    case JOYSTAT | 0:
-    case JOYSTAT | 1:
-    case JOYSTAT | 2:
-    case JOYSTAT | 3: {
-      serial_bus.Write(address, value);
-      break;
+    if (write != nullptr) {
+      entry.write = write;
     }
+  };
 
-    case KEYCNT: {
-      mmio.keycnt.input_mask &= 0xFF00;
-      mmio.keycnt.input_mask |= value;
-      CheckKeypadInterrupt();
-      break;
-    }
-    case KEYCNT+1: {
-      mmio.keycnt.input_mask &= 0x00FF;
-      mmio.keycnt.input_mask |= (value & 3) << 8;
-      mmio.keycnt.interrupt = value & 64;
-      mmio.keycnt.and_mode = value & 128;
-      CheckKeypadInterrupt();
-      break;
-    }
+  /* PPU */
+  map(DISPCNT,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return ReadLanes(cpu.ppu->mmio.dispcnt, 0);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      WriteLanes(cpu.ppu->mmio.dispcnt, 0, value, mask);
+    });
 
-    /* Interrupt Control */
-    case IE+0: irq_controller.Write(0, value); break;
-    case IE+1: irq_controller.Write(1, value); break;
-    case IF+0: irq_controller.Write(2, value); break;
-    case IF+1: irq_controller.Write(3, value); break;
-    case IME:  irq_controller.Write(4, value); break;
-
-    /* Waitstates */
-    case WAITCNT+0: {
-      mmio.waitcnt.sram  = (value >> 0) & 3;
-      mmio.waitcnt.ws0_n = (value >> 2) & 3;
-      mmio.waitcnt.ws0_s = (value >> 4) & 1;
-      mmio.waitcnt.ws1_n = (value >> 5) & 3;
-      mmio.waitcnt.ws1_s = (value >> 7) & 1;
-      UpdateMemoryDelayTable();
-      break;
-    }
-    case WAITCNT+1: {
-      mmio.waitcnt.ws2_n = (value >> 0) & 3;
-      mmio.waitcnt.ws2_s = (value >> 2) & 1;
-      mmio.waitcnt.phi = (value >> 3) & 3;
-      mmio.waitcnt.prefetch = (value >> 6) & 1;
-      mmio.waitcnt.cgb = (value >> 7) & 1;
-      UpdateMemoryDelayTable();
-      break;
+  map(DISPSTAT,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return cpu.ppu->mmio.dispstat.Read();
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      cpu.ppu->mmio.dispstat.Write(value, mask);
+    });
+
+  map(VCOUNT,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return cpu.ppu->mmio.vcount & 0xFF;
+    }, nullptr);
+
+  for (int id = 0; id < 4; id++) {
+    map(BG0CNT + id * 2,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        return ReadLanes(cpu.ppu->mmio.bgcnt[(address - BG0CNT) >> 1], 0);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        WriteLanes(cpu.ppu->mmio.bgcnt[(address - BG0CNT) >> 1], 0, value, mask);
+      });
+
+    map(BG0HOFS + id * 4, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        auto& bghofs = cpu.ppu->mmio.bghofs[(address >> 2) & 3];
+        bghofs = ((bghofs & ~mask) | (value & mask)) & 0x1FF;
+      });
+
+    map(BG0VOFS + id * 4, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        auto& bgvofs = cpu.ppu->mmio.bgvofs[(address >> 2) & 3];
+        bgvofs = ((bgvofs & ~mask) | (value & mask)) & 0x1FF;
+      });
+  }
+
+  for (int id = 0; id < 2; id++) {
+    map(BG2PA + id * 0x10, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        auto& bgpa = cpu.ppu->mmio.bgpa[(address >> 4) & 1];
+        bgpa = (bgpa & ~mask) | (value & mask);
+      });
+
+    map(BG2PB + id * 0x10, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        auto& bgpb = cpu.ppu->mmio.bgpb[(address >> 4) & 1];
+        bgpb = (bgpb & ~mask) | (value & mask);
+      });
+
+    map(BG2PC + id * 0x10, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        auto& bgpc = cpu.ppu->mmio.bgpc[(address >> 4) & 1];
+        bgpc = (bgpc & ~mask) | (value & mask);
+      });
+
+    map(BG2PD + id * 0x10, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        auto& bgpd = cpu.ppu->mmio.bgpd[(address >> 4) & 1];
+        bgpd = (bgpd & ~mask) | (value & mask);
+      });
+
+    for (int half = 0; half < 4; half += 2) {
+      map(BG2X + id * 0x10 + half, nullptr,
+        [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+          WriteLanes(cpu.ppu->mmio.bgx[(address >> 4) & 1], address & 2, value, mask);
+        });
+
+      map(BG2Y + id * 0x10 + half, nullptr,
+        [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+          WriteLanes(cpu.ppu->mmio.bgy[(address >> 4) & 1], address & 2, value, mask);
+        });
     }
 
-    case HALTCNT: {
-      if (value & 0x80) {
-        mmio.haltcnt = HaltControl::STOP;
-      } else {
-        mmio.haltcnt = HaltControl::HALT;
+    map(WIN0H + id * 2, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        WriteLanes(cpu.ppu->mmio.winh[(address >> 1) & 1], 0, value, mask);
+      });
+
+    map(WIN0V + id * 2, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        WriteLanes(cpu.ppu->mmio.winv[(address >> 1) & 1], 0, value, mask);
+      });
+  }
+
+  map(WININ,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return ReadLanes(cpu.ppu->mmio.winin, 0);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      WriteLanes(cpu.ppu->mmio.winin, 0, value, mask);
+    });
+
+  map(WINOUT,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return ReadLanes(cpu.ppu->mmio.winout, 0);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      WriteLanes(cpu.ppu->mmio.winout, 0, value, mask);
+    });
+
+  map(MOSAIC, nullptr,
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      WriteLanes(cpu.ppu->mmio.mosaic, 0, value, mask);
+    });
+
+  map(BLDCNT,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return ReadLanes(cpu.ppu->mmio.bldcnt, 0);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      WriteLanes(cpu.ppu->mmio.bldcnt, 0, value, mask);
+    });
+
+  map(BLDALPHA,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return cpu.ppu->mmio.eva | (cpu.ppu->mmio.evb << 8);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      if (mask & 0x00FF) {
+        cpu.ppu->mmio.eva = value & 0x1F;
       }
-      break;
+      if (mask & 0xFF00) {
+        cpu.ppu->mmio.evb = (value >> 8) & 0x1F;
+      }
+    });
+
+  map(BLDY, nullptr,
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      if (mask & 0x00FF) {
+        cpu.ppu->mmio.evy = value & 0x1F;
+      }
+    });
+
+  /* DMAs 0-3 */
+  for (int id = 0; id < 4; id++) {
+    for (int offset = 0; offset < 12; offset += 2) {
+      ReadFn read = nullptr;
+
+      if (offset == 8) {
+        read = read_zero;
+      } else if (offset == 10) {
+        read = [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+          return cpu.dma.Read((address - DMA0SAD) / 12, 10);
+        };
+      }
+
+      map(DMA0SAD + id * 12 + offset, read,
+        [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+          auto offset = address - DMA0SAD;
+          cpu.dma.Write(offset / 12, offset % 12, value, mask);
+        });
     }
+  }
+
+  /* SOUND */
+  for (int offset = 0; offset < 6; offset += 2) {
+    map(SOUND1CNT_L + offset,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        return ReadLanes(cpu.apu.psg1, address - SOUND1CNT_L);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        WriteLanes(cpu.apu.psg1, address - SOUND1CNT_L, value, mask);
+      });
+
+    map(SOUND3CNT_L + offset,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        return ReadLanes(cpu.apu.psg3, address - SOUND3CNT_L);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        WriteLanes(cpu.apu.psg3, address - SOUND3CNT_L, value, mask);
+      });
+  }
+
+  map(SOUND2CNT_L,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return ReadLanes(cpu.apu.psg2, 2);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      WriteLanes(cpu.apu.psg2, 2, value, mask);
+    });
+
+  map(SOUND2CNT_H,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return ReadLanes(cpu.apu.psg2, 4);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      WriteLanes(cpu.apu.psg2, 4, value, mask);
+    });
+
+  for (auto reg : { SOUND4CNT_L, SOUND4CNT_H }) {
+    map(reg,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        return ReadLanes(cpu.apu.psg4, address - SOUND4CNT_L);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        WriteLanes(cpu.apu.psg4, address - SOUND4CNT_L, value, mask);
+      });
+  }
+
+  for (auto reg : { SOUND1CNT_X + 2, SOUND2CNT_H + 2, SOUND3CNT_X + 2,
+                        SOUND4CNT_L + 2, SOUND4CNT_H + 2, SOUNDCNT_X + 2, SOUNDBIAS + 2 }) {
+    map(reg, read_zero, nullptr);
+  }
+
+  for (int offset = 0; offset < 16; offset += 2) {
+    map(WAVE_RAM + offset,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        auto& psg3 = cpu.apu.psg3;
+
+        return psg3.ReadSample((address & 0xF) + 0) |
+              (psg3.ReadSample((address & 0xF) + 1) << 8);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        auto& psg3 = cpu.apu.psg3;
+
+        if (mask & 0x00FF) {
+          psg3.WriteSample((address & 0xF) + 0, value & 0xFF);
+        }
+        if (mask & 0xFF00) {
+          psg3.WriteSample((address & 0xF) + 1, value >> 8);
+        }
+      });
+  }
+
+  for (int offset = 0; offset < 8; offset += 2) {
+    map(FIFO_A + offset, nullptr,
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        auto& fifo = cpu.apu.mmio.fifo[(address >> 2) & 1];
+
+        if (mask & 0x00FF) {
+          fifo.Write(value & 0xFF);
+        }
+        if (mask & 0xFF00) {
+          fifo.Write(value >> 8);
+        }
+      });
+  }
+
+  for (auto reg : { SOUNDCNT_L, SOUNDCNT_H }) {
+    map(reg,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        return ReadLanes(cpu.apu.mmio.soundcnt, address - SOUNDCNT_L);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        WriteLanes(cpu.apu.mmio.soundcnt, address - SOUNDCNT_L, value, mask);
+      });
+  }
+
+  map(SOUNDCNT_X,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return cpu.apu.mmio.soundcnt.Read(4);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      if (mask & 0x00FF) {
+        cpu.apu.mmio.soundcnt.Write(4, value & 0xFF);
+      }
+    });
+
+  map(SOUNDBIAS,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return ReadLanes(cpu.apu.mmio.bias, 0);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      WriteLanes(cpu.apu.mmio.bias, 0, value, mask);
+    });
+
+  /* Timers 0-3 */
+  for (int offset = 0; offset < 16; offset += 2) {
+    map(TM0CNT_L + offset,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        return cpu.timer.Read((address >> 2) & 3, address & 2);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        cpu.timer.Write((address >> 2) & 3, address & 2, value, mask);
+      });
+  }
+
+  /* Serial Communication (1, 2) */
+  for (auto reg : { SIOMULTI0, SIOMULTI1, SIOMULTI2, SIOMULTI3, SIOCNT, SIOMLT_SEND,
+                        RCNT, RCNT + 2, JOYCNT, JOYCNT + 2, JOY_RECV, JOY_RECV + 2,
+                        JOY_TRANS, JOY_TRANS + 2, JOYSTAT, JOYSTAT + 2 }) {
+    map(reg,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        return cpu.serial_bus.Read(address + 0) | (cpu.serial_bus.Read(address + 1) << 8);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        if (mask & 0x00FF) {
+          cpu.serial_bus.Write(address + 0, value & 0xFF);
+        }
+        if (mask & 0xFF00) {
+          cpu.serial_bus.Write(address + 1, value >> 8);
+        }
+      });
+  }
+
+  /* Keypad */
+  map(KEYINPUT,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return cpu.mmio.keyinput;
+    }, nullptr);
+
+  map(KEYCNT,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      auto& keycnt = cpu.mmio.keycnt;
+
+      return (keycnt.input_mask & 0x3FF) |
+             (keycnt.interrupt << 14) |
+             (keycnt.and_mode  << 15);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      auto& keycnt = cpu.mmio.keycnt;
+
+      if (mask & 0x00FF) {
+        keycnt.input_mask = (keycnt.input_mask & 0xFF00) | (value & 0xFF);
+      }
+      if (mask & 0xFF00) {
+        keycnt.input_mask = (keycnt.input_mask & 0x00FF) | (value & 0x300);
+        keycnt.interrupt = value & 0x4000;
+        keycnt.and_mode  = value & 0x8000;
+      }
+      cpu.CheckKeypadInterrupt();
+    });
+
+  /* Interrupt Control */
+  for (auto reg : { IE, IF }) {
+    map(reg,
+      [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+        return cpu.irq_controller.Read(address & 2);
+      },
+      [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+        cpu.irq_controller.Write(address & 2, value, mask);
+      });
+  }
+
+  map(IME,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      return cpu.irq_controller.Read(4);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      cpu.irq_controller.Write(4, value, mask);
+    });
+
+  map(IME + 2, read_zero, nullptr);
+
+  /* Waitstates */
+  map(WAITCNT,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      auto& waitcnt = cpu.mmio.waitcnt;
+
+      return waitcnt.sram |
+            (waitcnt.ws0_n << 2) |
+            (waitcnt.ws0_s << 4) |
+            (waitcnt.ws1_n << 5) |
+            (waitcnt.ws1_s << 7) |
+            (waitcnt.ws2_n << 8) |
+            (waitcnt.ws2_s << 10) |
+            (waitcnt.phi << 11) |
+            (waitcnt.prefetch << 14);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      auto& waitcnt = cpu.mmio.waitcnt;
+
+      if (mask & 0x00FF) {
+        waitcnt.sram  = (value >> 0) & 3;
+        waitcnt.ws0_n = (value >> 2) & 3;
+        waitcnt.ws0_s = (value >> 4) & 1;
+        waitcnt.ws1_n = (value >> 5) & 3;
+        waitcnt.ws1_s = (value >> 7) & 1;
+      }
+      if (mask & 0xFF00) {
+        waitcnt.ws2_n = (value >>  8) & 3;
+        waitcnt.ws2_s = (value >> 10) & 1;
+        waitcnt.phi = (value >> 11) & 3;
+        waitcnt.prefetch = (value >> 14) & 1;
+        waitcnt.cgb = (value >> 15) & 1;
+      }
+      cpu.UpdateMemoryDelayTable();
+    });
+
+  map(WAITCNT + 2, read_zero, nullptr);
+
+  /* POSTFLG (lower byte) and HALTCNT (upper byte) */
+  map(POSTFLG,
+    [](CPU& cpu, std::uint32_t address) -> std::uint16_t {
+      // HALTCNT is write-only.
+      return cpu.mmio.postflg | (cpu.ReadUnused(address) & 0xFF00);
+    },
+    [](CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+      if (mask & 0x00FF) {
+        cpu.mmio.postflg = value & 1;
+      }
+      if (mask & 0xFF00) {
+        if (value & 0x8000) {
+          cpu.mmio.haltcnt = HaltControl::STOP;
+        } else {
+          cpu.mmio.haltcnt = HaltControl::HALT;
+        }
+      }
+    });
+
+  return table;
+}
+
+auto CPU::ReadMMIO(std::uint32_t address) -> std::uint16_t {
+  if (address >= 0x04000400) {
+    return ReadUnused(address);
+  }
+
+  return s_mmio_table.registers[(address & 0x3FF) >> 1].read(*this, address);
+}
+
+void CPU::WriteMMIO(std::uint32_t address, std::uint16_t value, std::uint16_t mask) {
+  if (address < 0x04000400) {
+    s_mmio_table.registers[(address & 0x3FF) >> 1].write(*this, address, value, mask);
+  }
 
-    case POSTFLG: mmio.postflg = value & 1; break;
+  if (address < 0x4000060) {
+    HookMMIO(address & 0x7F);
   }
-  if (address < 0x4000060)
-    ppu->HookMMIO(address & 0x7F);
 }
 
 } // namespace nba::core
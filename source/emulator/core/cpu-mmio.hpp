@@ -109,3 +109,26 @@ constexpr std::uint32_t WAITCNT = 0x04000204;
 constexpr std::uint32_t IME = 0x04000208;
 constexpr std::uint32_t POSTFLG = 0x04000300;
 constexpr std::uint32_t HALTCNT = 0x04000301;
+
+namespace nba::core {
+
+class CPU;
+
+/* I/O registers are dispatched at their native 16-bit width through a table
+ * with one entry per halfword in 0x04000000 - 0x040003FF.
+ * Byte writes are forwarded with a mask that selects the written byte lanes,
+ * so that a handler can merge them into the current register state and
+ * run its side effects once per access.
+ */
+struct MMIORegister {
+  auto (*read )(CPU& cpu, std::uint32_t address) -> std::uint16_t;
+  void (*write)(CPU& cpu, std::uint32_t address, std::uint16_t value, std::uint16_t mask);
+};
+
+struct MMIOTable {
+  static constexpr int kRegisterCount = 0x200;
+
+  MMIORegister registers[kRegisterCount];
+};
+
+} // namespace nba::core
@@ -6,8 +6,7 @@
  */
 
 #include "cpu.hpp"
-#include "hw/ppu/software_render/software_renderer.hpp"
-#include "hw/ppu/vulkan_render/vulkan_renderer.hpp"
+#include "hw/ppu/renderer.hpp"
 
 #include <algorithm>
 #include <cstring>
@@ -25,12 +24,18 @@ using Key = InputDevice::Key;
 CPU::CPU(std::shared_ptr<Config> config)
   : ARM7TDMI::ARM7TDMI(this)
   , config(config)
-  , dma(this, &irq_controller, &scheduler)
+  , arena(0x80000, { config->memory.huge_pages, config->memory.numa_node })
+  , dma(this, this, &irq_controller, &scheduler)
   , apu(&scheduler, &dma, config)
-  , ppu(std::make_unique<VulkanRenderer>(&scheduler, &irq_controller, &dma, config))
   , timer(&scheduler, &irq_controller, &apu)
   , serial_bus(&irq_controller)
 {
+  memory.iram = arena.Allocate(0x08000);
+  memory.wram = arena.Allocate(0x40000);
+  memory.bios = arena.Allocate(0x04000);
+
+  ppu = CreateRenderer(&scheduler, &irq_controller, &dma, config, arena, renderer);
+
   std::memset(memory.bios, 0, 0x04000);
   memory.rom.size = 0;
   memory.rom.mask = 0;
@@ -175,6 +180,88 @@ void CPU::PrefetchStepROM(std::uint32_t address, int cycles) {
   Tick(cycles);
 }
 
+auto CPU::GetBurstPointer(std::uint32_t address, std::uint32_t& span) -> std::uint8_t* {
+  switch (address >> 24) {
+    case REGION_EWRAM: {
+      address &= 0x3FFFF;
+      span = 0x40000 - address;
+      return &memory.wram[address];
+    }
+    case REGION_IWRAM: {
+      address &= 0x7FFF;
+      span = 0x8000 - address;
+      return &memory.iram[address];
+    }
+    case REGION_PRAM: {
+      address &= 0x3FF;
+      span = 0x400 - address;
+      return &ppu->pram[address];
+    }
+    case REGION_VRAM: {
+      /* The upper 32 KiB mirror the OBJ tile area at 0x10000 - 0x17FFF. */
+      address &= 0x1FFFF;
+      if (address >= 0x18000) {
+        span = 0x20000 - address;
+        address &= ~0x8000;
+      } else {
+        span = 0x18000 - address;
+      }
+      return &ppu->vram[address];
+    }
+    case REGION_OAM: {
+      address &= 0x3FF;
+      span = 0x400 - address;
+      return &ppu->oam[address];
+    }
+  }
+
+  return nullptr;
+}
+
+auto CPU::GetBurstCycles(std::uint32_t address, bool word) -> int {
+  /* Plain memory has the same timing for sequential and non-sequential accesses. */
+  if (word) {
+    return cycles32[int(Access::Sequential)][address >> 24];
+  }
+  return cycles16[int(Access::Sequential)][address >> 24];
+}
+
+void CPU::TickBurst(int read_cycles, int write_cycles, int count) {
+  /* While the prefetch buffer is being filled each access must be stepped individually.
+   * Once it is full (or not prefetching at all) accesses only advance time.
+   */
+  if (mmio.waitcnt.prefetch) {
+    while (count > 0 && (prefetch.active || (prefetch.count < prefetch.capacity && state.r15 == last_rom_address))) {
+      PrefetchStepRAM(read_cycles);
+      PrefetchStepRAM(write_cycles);
+      count--;
+    }
+  }
+
+  Tick((read_cycles + write_cycles) * count);
+}
+
+void CPU::OnBurstWrite(std::uint32_t address, std::uint32_t size) {
+  switch (address >> 24) {
+    case REGION_PRAM: {
+      HookPRAM(address & 0x3FF, size);
+      break;
+    }
+    case REGION_VRAM: {
+      address &= 0x1FFFF;
+      if (address >= 0x18000) {
+        address &= ~0x8000;
+      }
+      HookVRAM(address, size);
+      break;
+    }
+    case REGION_OAM: {
+      HookOAM(address & 0x3FF, size);
+      break;
+    }
+  }
+}
+
 void CPU::RunFor(int cycles) {
   bool m4a_xq_enable = config->audio.m4a_xq_enable && m4a_setfreq_address != 0;
 
@@ -267,7 +354,7 @@ void CPU::M4ASearchForSampleFreqSet() {
     0x1E, 0x48, 0x04, 0x68, 0xF0, 0x20, 0x00, 0x03,
     0x10, 0x40, 0x02, 0x0C
   };
-  for (std::uint32_t i = 0; i < memory.rom.size; i++) {
+  for (std::uint32_t i = 0; i + sizeof(pattern) <= memory.rom.size; i++) {
     bool match = true;
     for (int j = 0; j < sizeof(pattern); j++) {
       if (memory.rom.data[i + j] != pattern[j]) {
@@ -9,6 +9,7 @@
 
 #include <common/log.hpp>
 #include <common/m4a.hpp>
+#include <common/memory_arena.hpp>
 #include <emulator/cartridge/backup/backup.hpp>
 #include <emulator/cartridge/gpio/gpio.hpp>
 #include <emulator/config/config.hpp>
@@ -17,6 +18,7 @@
 #include "arm/arm7tdmi.hpp"
 #include "hw/apu/apu.hpp"
 #include "hw/ppu/ppu.hpp"
+#include "hw/ppu/renderer.hpp"
 #include "hw/dma.hpp"
 #include "hw/interrupt.hpp"
 #include "hw/serial.hpp"
@@ -25,7 +27,9 @@
 
 namespace nba::core {
 
-class CPU final : private arm::ARM7TDMI, private arm::MemoryBase {
+struct MMIOTable;
+
+class CPU final : private arm::ARM7TDMI, private arm::MemoryBase, private DMA::BurstBus {
 public:
   using Access = arm::MemoryBase::Access;
 
@@ -60,13 +64,22 @@ public:
 
   std::shared_ptr<Config> config;
 
+private:
+  /// Backing memory of the fixed-size guest memory regions, including video memory.
+  /// It is declared before the components that point into it, so it is destroyed after them.
+  common::MemoryArena arena;
+
+public:
+  /* BIOS, WRAM and IWRAM are carved out of the CPU's memory arena.
+   * The ROM is a read-only image shared with other instances (see ROMCache).
+   */
   struct SystemMemory {
-    std::uint8_t bios[0x04000];
-    std::uint8_t wram[0x40000];
-    std::uint8_t iram[0x08000];
+    std::uint8_t* bios;
+    std::uint8_t* wram;
+    std::uint8_t* iram;
 
     struct ROM {
-      std::unique_ptr<uint8_t[]> data;
+      std::shared_ptr<std::uint8_t[]> data;
       size_t size;
       std::uint32_t mask = 0x1FFFFFF;
       std::unique_ptr<nba::GPIO> gpio;
@@ -133,8 +146,8 @@ private:
     return memory.rom.backup_eeprom && ((~memory.rom.size & 0x02000000) || address >= 0x0DFFFF00);
   }
 
-  auto ReadMMIO (std::uint32_t address) -> std::uint8_t;
-  void WriteMMIO(std::uint32_t address, std::uint8_t value);
+  auto ReadMMIO (std::uint32_t address) -> std::uint16_t;
+  void WriteMMIO(std::uint32_t address, std::uint16_t value, std::uint16_t mask);
   auto ReadBIOS(std::uint32_t address) -> std::uint32_t;
   auto ReadUnused(std::uint32_t address) -> std::uint32_t;
 
@@ -145,6 +158,27 @@ private:
   void WriteHalf(std::uint32_t address, std::uint16_t value, Access access) final;
   void WriteWord(std::uint32_t address, std::uint32_t value, Access access) final;
 
+  auto GetBurstPointer(std::uint32_t address, std::uint32_t& span) -> std::uint8_t* final;
+  auto GetBurstCycles(std::uint32_t address, bool word) -> int final;
+  void TickBurst(int read_cycles, int write_cycles, int count) final;
+  void OnBurstWrite(std::uint32_t address, std::uint32_t size) final;
+
+  void HookPRAM(std::uint32_t address, std::uint32_t size) {
+    std::visit([=](auto renderer) { renderer->HookPRAM(address, size); }, renderer);
+  }
+
+  void HookVRAM(std::uint32_t address, std::uint32_t size) {
+    std::visit([=](auto renderer) { renderer->HookVRAM(address, size); }, renderer);
+  }
+
+  void HookOAM(std::uint32_t address, std::uint32_t size) {
+    std::visit([=](auto renderer) { renderer->HookOAM(address, size); }, renderer);
+  }
+
+  void HookMMIO(std::uint32_t address) {
+    std::visit([=](auto renderer) { renderer->HookMMIO(address); }, renderer);
+  }
+
   void Tick(int cycles);
   void Idle() final;
   void PrefetchStepRAM(int cycles);
@@ -176,6 +210,8 @@ private:
 
   std::uint32_t last_rom_address;
 
+  RendererRef renderer;
+
   struct IRQ {
     bool processing = false;
     int countdown = 0;
@@ -195,6 +231,9 @@ private:
   static constexpr int s_ws_seq0[2] = { 2, 1 };       /* Sequential WS0 */
   static constexpr int s_ws_seq1[2] = { 4, 1 };       /* Sequential WS1 */
   static constexpr int s_ws_seq2[2] = { 8, 1 };       /* Sequential WS2 */
+
+  static auto CreateMMIOTable() -> MMIOTable;
+  static const MMIOTable s_mmio_table;
 };
 
 #include "cpu-memory.inl"
@@ -5,6 +5,8 @@
  * Refer to the included LICENSE file.
  */
 
+#include <algorithm>
+#include <cstring>
 #include <emulator/core/cpu-mmio.hpp>
 
 #include "dma.hpp"
@@ -163,6 +165,11 @@ void DMA::Run() {
       return;
     }
 
+    if (!channel.is_fifo_dma && RunBurst(channel, size, src_modify, dst_modify)) {
+      access = Access::Sequential;
+      continue;
+    }
+
     if (size == Channel::Half) {
       if (channel.latch.src_addr >= 0x02000000) {
         auto value = memory->ReadHalf(channel.latch.src_addr, access);
@@ -217,69 +224,146 @@ void DMA::Run() {
   SelectNextDMA();
 }
 
-auto DMA::Read(int chan_id, int offset) -> std::uint8_t {
+bool DMA::RunBurst(Channel& channel, int size, int src_modify, int dst_modify) {
+  std::uint32_t unit = (size == Channel::Word) ? 4 : 2;
+
+  // Only incrementing or fixed addresses can be transferred in bulk.
+  if ((src_modify != 0 && src_modify != int(unit)) ||
+      (dst_modify != 0 && dst_modify != int(unit))) {
+    return false;
+  }
+
+  // The bus ignores the low address bits, just like on a per-unit access.
+  auto src_addr = channel.latch.src_addr & ~(unit - 1);
+  auto dst_addr = channel.latch.dst_addr & ~(unit - 1);
+  std::uint32_t src_span;
+  std::uint32_t dst_span;
+  auto src = burst_bus->GetBurstPointer(src_addr, src_span);
+  auto dst = burst_bus->GetBurstPointer(dst_addr, dst_span);
+
+  if (src == nullptr || dst == nullptr) {
+    return false;
+  }
+
+  int read_cycles  = burst_bus->GetBurstCycles(src_addr, size == Channel::Word);
+  int write_cycles = burst_bus->GetBurstCycles(dst_addr, size == Channel::Word);
+  int unit_cycles  = read_cycles + write_cycles;
+
+  /* Run up to the next scheduler event, so that events (and the DMAs requested by them)
+   * are serviced after exactly the same unit as in the per-access path.
+   */
+  int remaining = std::max(scheduler->GetRemainingCycleCount(), 1);
+  std::uint32_t count = (remaining + unit_cycles - 1) / unit_cycles;
+
+  count = std::min(count, channel.latch.length);
+  if (src_modify != 0) count = std::min(count, src_span / unit);
+  if (dst_modify != 0) count = std::min(count, dst_span / unit);
+
+  if (count == 0) {
+    return false;
+  }
+
+  /* A destination ahead of an incrementing source would be read back by later units,
+   * so stop the burst right before the source reaches the destination.
+   */
+  auto src_begin = reinterpret_cast<std::uintptr_t>(src);
+  auto dst_begin = reinterpret_cast<std::uintptr_t>(dst);
+  if (src_modify != 0 && dst_begin > src_begin && dst_begin < src_begin + count * unit) {
+    count = (dst_begin - src_begin) / unit;
+    if (count == 0) {
+      return false;
+    }
+  }
+
+  /* Latch the value of the last unit read, just like the per-access path. */
+  auto last = src + (src_modify != 0 ? (count - 1) * unit : 0);
+  if (size == Channel::Half) {
+    std::uint16_t value;
+    std::memcpy(&value, last, sizeof(value));
+    latch = (value << 16) | value;
+  } else {
+    std::memcpy(&latch, last, sizeof(latch));
+  }
+
+  if (src_modify != 0 && dst_modify != 0) {
+    std::memmove(dst, src, count * unit);
+  } else if (dst_modify != 0) {
+    for (std::uint32_t i = 0; i < count; i++) {
+      std::memcpy(dst + i * unit, &latch, unit);
+    }
+  } else {
+    std::memcpy(dst, &latch, unit);
+  }
+
+  burst_bus->OnBurstWrite(dst_addr, dst_modify != 0 ? count * unit : unit);
+  burst_bus->TickBurst(read_cycles, write_cycles, count);
+
+  channel.latch.src_addr += src_modify * count;
+  channel.latch.dst_addr += dst_modify * count;
+  channel.latch.length -= count;
+  return true;
+}
+
+auto DMA::Read(int chan_id, int offset) -> std::uint16_t {
   auto const& channel = channels[chan_id];
 
   switch (offset) {
-    case REG_DMAXCNT_H | 0: {
+    case REG_DMAXCNT_H: {
       return (channel.dst_cntl << 5) |
-             (channel.src_cntl << 7);
-    }
-    case REG_DMAXCNT_H | 1: {
-      return (channel.src_cntl  >> 1) |
-             (channel.size      << 2) |
-             (channel.time      << 4) |
-             (channel.repeat    ? 2   : 0) |
-             (channel.gamepak   ? 8   : 0) |
-             (channel.interrupt ? 64  : 0) |
-             (channel.enable    ? 128 : 0);
+             (channel.src_cntl << 7) |
+             (channel.size     << 10) |
+             (channel.time     << 12) |
+             (channel.repeat    ? (1 << 9)  : 0) |
+             (channel.gamepak   ? (1 << 11) : 0) |
+             (channel.interrupt ? (1 << 14) : 0) |
+             (channel.enable    ? (1 << 15) : 0);
     }
     default: return 0;
   }
 }
 
-void DMA::Write(int chan_id, int offset, std::uint8_t value) {
+void DMA::Write(int chan_id, int offset, std::uint16_t value, std::uint16_t mask) {
   auto& channel = channels[chan_id];
 
   switch (offset) {
     case REG_DMAXSAD | 0:
-    case REG_DMAXSAD | 1:
-    case REG_DMAXSAD | 2:
-    case REG_DMAXSAD | 3: {
+    case REG_DMAXSAD | 2: {
       int shift = offset * 8;
-      channel.src_addr &= ~(0xFFUL << shift);
-      channel.src_addr |= (value << shift) & g_dma_src_mask[chan_id];
+      channel.src_addr &= ~(std::uint32_t(mask) << shift);
+      channel.src_addr |= (std::uint32_t(value & mask) << shift) & g_dma_src_mask[chan_id];
       break;
     }
     case REG_DMAXDAD | 0:
-    case REG_DMAXDAD | 1:
-    case REG_DMAXDAD | 2:
-    case REG_DMAXDAD | 3: {
+    case REG_DMAXDAD | 2: {
       int shift = (offset - 4) * 8;
-      channel.dst_addr &= ~(0xFFUL << shift);
-      channel.dst_addr |= (value << shift) & g_dma_dst_mask[chan_id];
+      channel.dst_addr &= ~(std::uint32_t(mask) << shift);
+      channel.dst_addr |= (std::uint32_t(value & mask) << shift) & g_dma_dst_mask[chan_id];
       break;
     }
-    case REG_DMAXCNT_L | 0: channel.length = (channel.length & 0xFF00) | (value << 0); break;
-    case REG_DMAXCNT_L | 1: channel.length = (channel.length & 0x00FF) | (value << 8); break;
-    case REG_DMAXCNT_H | 0: {
-      channel.dst_cntl = static_cast<Channel::Control>((value >> 5) & 3);
-      channel.src_cntl = static_cast<Channel::Control>((channel.src_cntl & 0b10) | (value>>7));
+    case REG_DMAXCNT_L: {
+      channel.length = (channel.length & ~mask) | (value & mask);
       break;
     }
-    case REG_DMAXCNT_H | 1: {
-      bool enable_old = channel.enable;
-
-      // TODO: check that the actual repeat bit is masked if immediate transfer is selected.
-      channel.src_cntl  = Channel::Control((channel.src_cntl & 0b01) | ((value & 1) << 1));
-      channel.size = static_cast<Channel::Size>((value >> 2) & 1);
-      channel.time = static_cast<Channel::Timing>((value >> 4) & 3);
-      channel.repeat  = (value & 2) && channel.time != Channel::Immediate;
-      channel.gamepak = (value & 8) && chan_id == 3;
-      channel.interrupt = value & 64;
-      channel.enable = value & 128;
-
-      OnChannelWritten(channel, enable_old);
+    case REG_DMAXCNT_H: {
+      if (mask & 0x00FF) {
+        channel.dst_cntl = static_cast<Channel::Control>((value >> 5) & 3);
+        channel.src_cntl = static_cast<Channel::Control>((channel.src_cntl & 0b10) | ((value >> 7) & 1));
+      }
+
+      if (mask & 0xFF00) {
+        bool enable_old = channel.enable;
+
+        // TODO: check that the actual repeat bit is masked if immediate transfer is selected.
+        channel.src_cntl  = Channel::Control((channel.src_cntl & 0b01) | (((value >> 8) & 1) << 1));
+        channel.size = static_cast<Channel::Size>((value >> 10) & 1);
+        channel.time = static_cast<Channel::Timing>((value >> 12) & 3);
+        channel.repeat  = (value & (1 << 9)) && channel.time != Channel::Immediate;
+        channel.gamepak = (value & (1 << 11)) && chan_id == 3;
+        channel.interrupt = value & (1 << 14);
+        channel.enable = value & (1 << 15);
+
+        OnChannelWritten(channel, enable_old);
+      }
       break;
     }
   }
@@ -19,10 +19,31 @@ class DMA {
 public:
   using Access = arm::MemoryBase::Access;
 
+  /* Direct view of the plain memory regions (work RAM, palette RAM, VRAM and OAM).
+   * Transfers which only touch these regions are executed in bursts,
+   * without going through the per-access bus emulation.
+   */
+  struct BurstBus {
+    /// Returns the host memory backing an address or nullptr if it is not plain memory.
+    /// The number of bytes that are contiguous from the address is stored in span.
+    virtual auto GetBurstPointer(std::uint32_t address, std::uint32_t& span) -> std::uint8_t* = 0;
+
+    /// Returns the cycle count of a single access (16-bit or 32-bit) to plain memory.
+    virtual auto GetBurstCycles(std::uint32_t address, bool word) -> int = 0;
+
+    /// Advances the system by count read-write access pairs.
+    virtual void TickBurst(int read_cycles, int write_cycles, int count) = 0;
+
+    /// Notifies the bus that a block of memory has been written.
+    virtual void OnBurstWrite(std::uint32_t address, std::uint32_t size) = 0;
+  };
+
   DMA(arm::MemoryBase* memory,
+      BurstBus* burst_bus,
       InterruptController* irq_controller,
       Scheduler* scheduler)
     : memory(memory)
+    , burst_bus(burst_bus)
     , irq_controller(irq_controller)
     , scheduler(scheduler)
   { Reset(); }
@@ -39,8 +60,8 @@ public:
   void Request(Occasion occasion);
   void StopVideoXferDMA();
   void Run();
-  auto Read (int chan_id, int offset) -> std::uint8_t;
-  void Write(int chan_id, int offset, std::uint8_t value);
+  auto Read (int chan_id, int offset) -> std::uint16_t;
+  void Write(int chan_id, int offset, std::uint16_t value, std::uint16_t mask);
   bool IsRunning() { return runnable_set.any(); }
   auto GetOpenBusValue() -> std::uint32_t { return latch; }
 
@@ -103,11 +124,13 @@ private:
     return page;
   }
 
+  bool RunBurst(Channel& channel, int size, int src_modify, int dst_modify);
   void TryStart(int chan_id);
   void SelectNextDMA();
   void OnChannelWritten(Channel& channel, bool enable_old);
 
   arm::MemoryBase* memory;
+  BurstBus* burst_bus;
   InterruptController* irq_controller;
   Scheduler* scheduler;
 
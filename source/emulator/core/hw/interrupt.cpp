@@ -9,36 +9,28 @@
 
 namespace nba::core {
 
-auto InterruptController::Read(int offset) const -> std::uint8_t {
+auto InterruptController::Read(int offset) const -> std::uint16_t {
   switch (offset) {
-    case REG_IE|0: return reg_ie & 0xFF;
-    case REG_IE|1: return reg_ie >> 8;
-    case REG_IF|0: return reg_if & 0xFF;
-    case REG_IF|1: return reg_if >> 8;
-    case REG_IME:  return reg_ime ? 1 : 0;
+    case REG_IE:  return reg_ie;
+    case REG_IF:  return reg_if;
+    case REG_IME: return reg_ime ? 1 : 0;
   }
 
   return 0;
 }
 
-void InterruptController::Write(int offset, std::uint8_t value) {
+void InterruptController::Write(int offset, std::uint16_t value, std::uint16_t mask) {
   switch (offset) {
-    case REG_IE|0:
-      reg_ie &= 0xFF00;
-      reg_ie |= value;
+    case REG_IE:
+      reg_ie = (reg_ie & ~mask) | (value & mask);
       break;
-    case REG_IE|1:
-      reg_ie &= 0x00FF;
-      reg_ie |= value << 8;
-      break;
-    case REG_IF|0:
-      reg_if &= ~value;
-      break;
-    case REG_IF|1:
-      reg_if &= ~(value << 8);
+    case REG_IF:
+      reg_if &= ~(value & mask);
       break;
     case REG_IME:
-      reg_ime = value & 1;
+      if (mask & 0x00FF) {
+        reg_ime = value & 1;
+      }
       break;
   }
 }
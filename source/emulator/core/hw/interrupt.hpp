@@ -32,8 +32,8 @@ public:
     reg_if = 0;
   }
 
-  auto Read(int offset) const -> std::uint8_t;
-  void Write(int offset, std::uint8_t value);
+  auto Read(int offset) const -> std::uint16_t;
+  void Write(int offset, std::uint16_t value, std::uint16_t mask);
   void Raise(InterruptSource source, int id = 0);
 
   bool MasterEnable() const {
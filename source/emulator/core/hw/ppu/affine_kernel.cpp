@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <algorithm>
+
+#include "affine_kernel.hpp"
+#include "compositor.hpp"
+#include "cpu_features.hpp"
+
+namespace nba::core {
+
+#ifdef NBA_X86_SIMD
+
+/* Implemented in affine_kernel_avx2.cpp, which is built with AVX2 enabled. */
+void SampleTileMapAVX2(std::uint8_t const* vram,
+                       std::uint32_t map_base,
+                       std::uint32_t tile_base,
+                       int size,
+                       std::uint16_t* buffer,
+                       int count,
+                       std::int32_t ref_x,
+                       std::int32_t ref_y,
+                       std::int32_t dx,
+                       std::int32_t dy);
+
+#endif // NBA_X86_SIMD
+
+static auto FloorDiv(std::int64_t a, std::int64_t b) -> std::int64_t {
+  auto quotient = a / b;
+
+  if ((a % b) != 0 && ((a < 0) != (b < 0))) {
+    quotient--;
+  }
+
+  return quotient;
+}
+
+static auto CeilDiv(std::int64_t a, std::int64_t b) -> std::int64_t {
+  return -FloorDiv(-a, b);
+}
+
+/* Narrows [first, last] to the t for which 0 <= base + t * step < limit. */
+static void Narrow(std::int64_t& first, std::int64_t& last, std::int64_t base, std::int64_t step, std::int64_t limit) {
+  if (step == 0) {
+    if (base < 0 || base >= limit) {
+      last = first - 1;
+    }
+  } else if (step > 0) {
+    first = std::max(first, CeilDiv(-base, step));
+    last  = std::min(last, FloorDiv(limit - 1 - base, step));
+  } else {
+    first = std::max(first, CeilDiv(limit - 1 - base, step));
+    last  = std::min(last, FloorDiv(-base, step));
+  }
+}
+
+auto AffineKernel::VisibleSpan(std::int32_t ref_x,
+                               std::int32_t ref_y,
+                               std::int32_t dx,
+                               std::int32_t dy,
+                               int count,
+                               int width,
+                               int height) -> Span {
+  std::int64_t first = 0;
+  std::int64_t last = count - 1;
+
+  Narrow(first, last, ref_x, dx, std::int64_t{width} << 8);
+  Narrow(first, last, ref_y, dy, std::int64_t{height} << 8);
+
+  if (first > last) {
+    return { 0, 0 };
+  }
+
+  return { int(first), int(last) + 1 };
+}
+
+template<int size>
+static void SampleTileMapScalar(std::uint8_t const* vram,
+                                std::uint32_t map_base,
+                                std::uint32_t tile_base,
+                                std::uint16_t* buffer,
+                                int count,
+                                std::int32_t ref_x,
+                                std::int32_t ref_y,
+                                std::int32_t dx,
+                                std::int32_t dy) {
+  for (int i = 0; i < count; i++) {
+    int x = (ref_x >> 8) & (size - 1);
+    int y = (ref_y >> 8) & (size - 1);
+
+    int number = vram[map_base + (y >> 3) * (size / 8) + (x >> 3)];
+    int index  = vram[tile_base + number * 64 + (y & 7) * 8 + (x & 7)];
+
+    buffer[i] = index ? index : Compositor::s_color_transparent;
+
+    ref_x += dx;
+    ref_y += dy;
+  }
+}
+
+void AffineKernel::SampleTileMap(std::uint8_t const* vram,
+                                 std::uint32_t map_base,
+                                 std::uint32_t tile_base,
+                                 int size,
+                                 std::uint16_t* buffer,
+                                 int count,
+                                 std::int32_t ref_x,
+                                 std::int32_t ref_y,
+                                 std::int32_t dx,
+                                 std::int32_t dy) {
+#ifdef NBA_X86_SIMD
+  static bool const has_avx2 = HasAVX2();
+
+  if (has_avx2) {
+    SampleTileMapAVX2(vram, map_base, tile_base, size, buffer, count, ref_x, ref_y, dx, dy);
+    return;
+  }
+#endif
+
+  switch (size) {
+    case 128:  SampleTileMapScalar<128> (vram, map_base, tile_base, buffer, count, ref_x, ref_y, dx, dy); break;
+    case 256:  SampleTileMapScalar<256> (vram, map_base, tile_base, buffer, count, ref_x, ref_y, dx, dy); break;
+    case 512:  SampleTileMapScalar<512> (vram, map_base, tile_base, buffer, count, ref_x, ref_y, dx, dy); break;
+    case 1024: SampleTileMapScalar<1024>(vram, map_base, tile_base, buffer, count, ref_x, ref_y, dx, dy); break;
+  }
+}
+
+} // namespace nba::core
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace nba::core {
+
+/* Sampling stages of affine backgrounds, shared by the renderers.
+ * The texture is sampled along the line (ref_x, ref_y) + t * (dx, dy),
+ * with the coordinates given in 20.8 fixed point.
+ */
+struct AffineKernel {
+  struct Span {
+    int first;
+    int last;
+  };
+
+  /// Returns the range of t in [0, count) for which the sample lies within a width x height texture.
+  /// The samples are on a line, so the range is contiguous (and possibly empty).
+  static auto VisibleSpan(std::int32_t ref_x,
+                          std::int32_t ref_y,
+                          std::int32_t dx,
+                          std::int32_t dy,
+                          int count,
+                          int width,
+                          int height) -> Span;
+
+  /// Samples count pixels of an 8BPP tile map of size x size pixels into palette entries.
+  /// The coordinates wrap around, and vram must be readable up to three bytes past the sampled data.
+  static void SampleTileMap(std::uint8_t const* vram,
+                            std::uint32_t map_base,
+                            std::uint32_t tile_base,
+                            int size,
+                            std::uint16_t* buffer,
+                            int count,
+                            std::int32_t ref_x,
+                            std::int32_t ref_y,
+                            std::int32_t dx,
+                            std::int32_t dy);
+};
+
+} // namespace nba::core
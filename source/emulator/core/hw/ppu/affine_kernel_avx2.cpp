@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <immintrin.h>
+
+#include "compositor.hpp"
+
+namespace nba::core {
+
+/* Samples eight pixels at a time, gathering the tile numbers from the map
+ * and then the palette entries from the tiles.
+ */
+void SampleTileMapAVX2(std::uint8_t const* vram,
+                       std::uint32_t map_base,
+                       std::uint32_t tile_base,
+                       int size,
+                       std::uint16_t* buffer,
+                       int count,
+                       std::int32_t ref_x,
+                       std::int32_t ref_y,
+                       std::int32_t dx,
+                       std::int32_t dy) {
+  int shift = 0;
+
+  while ((8 << shift) < size) shift++;
+
+  auto const lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  auto const mask  = _mm256_set1_epi32(size - 1);
+  auto const bytes = _mm256_set1_epi32(0xFF);
+  auto const seven = _mm256_set1_epi32(7);
+  auto const zero  = _mm256_setzero_si256();
+  auto const transparent = _mm256_set1_epi32(Compositor::s_color_transparent);
+  auto const map_base_v  = _mm256_set1_epi32(std::int32_t(map_base));
+  auto const tile_base_v = _mm256_set1_epi32(std::int32_t(tile_base));
+  auto const step_x = _mm256_set1_epi32(dx * 8);
+  auto const step_y = _mm256_set1_epi32(dy * 8);
+
+  auto vx = _mm256_add_epi32(_mm256_set1_epi32(ref_x), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(dx)));
+  auto vy = _mm256_add_epi32(_mm256_set1_epi32(ref_y), _mm256_mullo_epi32(lanes, _mm256_set1_epi32(dy)));
+
+  auto base = (int const*)vram;
+
+  int i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    auto x = _mm256_and_si256(_mm256_srai_epi32(vx, 8), mask);
+    auto y = _mm256_and_si256(_mm256_srai_epi32(vy, 8), mask);
+
+    auto map = _mm256_add_epi32(map_base_v, _mm256_add_epi32(
+      _mm256_slli_epi32(_mm256_srli_epi32(y, 3), shift), _mm256_srli_epi32(x, 3)));
+    auto number = _mm256_and_si256(_mm256_i32gather_epi32(base, map, 1), bytes);
+
+    auto texel = _mm256_add_epi32(
+      _mm256_add_epi32(tile_base_v, _mm256_slli_epi32(number, 6)),
+      _mm256_add_epi32(_mm256_slli_epi32(_mm256_and_si256(y, seven), 3), _mm256_and_si256(x, seven)));
+    auto index = _mm256_and_si256(_mm256_i32gather_epi32(base, texel, 1), bytes);
+
+    index = _mm256_or_si256(index, _mm256_and_si256(_mm256_cmpeq_epi32(index, zero), transparent));
+
+    auto packed = _mm_packus_epi32(_mm256_castsi256_si128(index), _mm256_extracti128_si256(index, 1));
+    _mm_storeu_si128((__m128i*)&buffer[i], packed);
+
+    vx = _mm256_add_epi32(vx, step_x);
+    vy = _mm256_add_epi32(vy, step_y);
+  }
+
+  ref_x += i * dx;
+  ref_y += i * dy;
+
+  for (; i < count; i++) {
+    int x = (ref_x >> 8) & (size - 1);
+    int y = (ref_y >> 8) & (size - 1);
+
+    int number = vram[map_base + ((y >> 3) << shift) + (x >> 3)];
+    int index  = vram[tile_base + number * 64 + (y & 7) * 8 + (x & 7)];
+
+    buffer[i] = index ? index : Compositor::s_color_transparent;
+
+    ref_x += dx;
+    ref_y += dy;
+  }
+}
+
+} // namespace nba::core
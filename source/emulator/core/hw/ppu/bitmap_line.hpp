@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#endif
+
+namespace nba::core {
+
+/* Reads runs of consecutive bitmap pixels, for bitmap lines that are neither rotated nor scaled.
+ * SSE2 is part of every x86-64 CPU, so it is used without a runtime check.
+ */
+
+/// Reads count 8-bit palette indices (mode 4) as palette entries.
+inline void ReadBitmapLine8(std::uint16_t* buffer, std::uint8_t const* data, int count) {
+  int x = 0;
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+  auto const zero = _mm_setzero_si128();
+
+  for (; x + 16 <= count; x += 16) {
+    auto indices = _mm_loadu_si128((__m128i const*)&data[x]);
+
+    _mm_storeu_si128((__m128i*)&buffer[x + 0], _mm_unpacklo_epi8(indices, zero));
+    _mm_storeu_si128((__m128i*)&buffer[x + 8], _mm_unpackhi_epi8(indices, zero));
+  }
+#endif
+
+  for (; x < count; x++) {
+    buffer[x] = data[x];
+  }
+}
+
+/// Reads count little-endian 16-bit colors (modes 3 and 5).
+inline void ReadBitmapLine16(std::uint16_t* buffer, std::uint8_t const* data, int count) {
+  int x = 0;
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+  /* x86 is little-endian, so the colors are copied as they are. */
+  for (; x + 8 <= count; x += 8) {
+    _mm_storeu_si128((__m128i*)&buffer[x], _mm_loadu_si128((__m128i const*)&data[x * 2]));
+  }
+#endif
+
+  for (; x < count; x++) {
+    buffer[x] = (data[x * 2 + 1] << 8) | data[x * 2];
+  }
+}
+
+} // namespace nba::core
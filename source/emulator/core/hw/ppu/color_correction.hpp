@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <emulator/device/video_device.hpp>
+
+namespace nba::core {
+
+/* Emulates the colors of the GBA LCD on the CPU, the same way as shader/gba_colors.fs.
+ * Credits to Talarubi and Near for the color correction algorithm.
+ * https://byuu.net/video/color-emulation
+ *
+ * The corrected color of each 15-bit color is computed once, as ARGB8888.
+ */
+struct ColorCorrection {
+  /// Returns the table of corrected colors, which is built on first use.
+  static auto Table() -> std::uint32_t const* {
+    static ColorCorrection const instance;
+
+    return instance.table;
+  }
+
+private:
+  ColorCorrection() {
+    double linear[32];
+
+    /* The shader samples the 5-bit channels shifted up to eight bits, so the same input is used here. */
+    for (int i = 0; i < 32; i++) {
+      linear[i] = std::pow((i << 3) / 255.0, 4.0);
+    }
+
+    auto encode = [](double value) {
+      return int(std::round(std::pow(std::min(value, 1.0), 1.0 / 2.2) * 255.0));
+    };
+
+    for (int color = 0; color < 32768; color++) {
+      auto r = linear[(color >>  0) & 0x1F];
+      auto g = linear[(color >>  5) & 0x1F];
+      auto b = linear[(color >> 10) & 0x1F];
+
+      table[color] = 0xFF000000 |
+        encode(r + 0.196 * g) << 16 |
+        encode(0.039 * r + 0.901 * g + 0.117 * b) << 8 |
+        encode(0.196 * r + 0.039 * g + 0.862 * b);
+    }
+  }
+
+  std::uint32_t table[32768];
+};
+
+/// Like ConvertLine, but looks the colors up in a table of ARGB8888 colors first.
+inline void ConvertLine(PixelFormat format, std::uint32_t const* table, std::uint16_t const* colors, void* line) {
+  switch (format) {
+    case PixelFormat::BGR555:
+      for (int x = 0; x < 240; x++) {
+        auto argb = table[colors[x] & 0x7FFF];
+
+        ((std::uint16_t*)line)[x] = (argb >> 19 & 0x1F) | (argb >> 6 & 0x3E0) | (argb << 7 & 0x7C00);
+      }
+      break;
+    case PixelFormat::RGB565:
+      for (int x = 0; x < 240; x++) {
+        auto argb = table[colors[x] & 0x7FFF];
+
+        ((std::uint16_t*)line)[x] = (argb >> 8 & 0xF800) | (argb >> 5 & 0x7E0) | (argb >> 3 & 0x1F);
+      }
+      break;
+    case PixelFormat::ARGB8888:
+      for (int x = 0; x < 240; x++) {
+        ((std::uint32_t*)line)[x] = table[colors[x] & 0x7FFF];
+      }
+      break;
+    case PixelFormat::ABGR8888:
+      for (int x = 0; x < 240; x++) {
+        auto argb = table[colors[x] & 0x7FFF];
+
+        ((std::uint32_t*)line)[x] = (argb & 0xFF00FF00) | (argb >> 16 & 0xFF) | (argb << 16 & 0xFF0000);
+      }
+      break;
+  }
+}
+
+} // namespace nba::core
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <algorithm>
+
+#include "line_renderer.hpp"
+
+namespace nba::core {
+
+using BlendMode = BlendControl::Effect;
+
+void LineRenderer::RenderScanline() {
+  if (render_mmio.dispcnt.forced_blank) {
+    std::uint16_t white[240];
+
+    std::fill(std::begin(white), std::end(white), 0x7FFF);
+    OutputLine(white);
+    return;
+  }
+
+  if (render_mmio.dispcnt.enable[ENABLE_WIN0]) {
+    RenderWindow(0);
+  }
+
+  if (render_mmio.dispcnt.enable[ENABLE_WIN1]) {
+    RenderWindow(1);
+  }
+
+  switch (render_mmio.dispcnt.mode) {
+    case 0: {
+      /* BG Mode 0 - 240x160 pixels, Text mode */
+      for (int i = 0; i < 4; i++) {
+        if (render_mmio.dispcnt.enable[i]) {
+          RenderLayerText(i);
+        }
+      }
+      if (render_mmio.dispcnt.enable[ENABLE_OBJ]) {
+        RenderLayerOAM(false);
+      }
+      ComposeScanline(0, 3);
+      break;
+    }
+    case 1: {
+      /* BG Mode 1 - 240x160 pixels, Text and RS mode mixed */
+      for (int i = 0; i < 2; i++) {
+        if (render_mmio.dispcnt.enable[i]) {
+          RenderLayerText(i);
+        }
+      }
+      if (render_mmio.dispcnt.enable[ENABLE_BG2]) {
+        RenderLayerAffine(0);
+      }
+      if (render_mmio.dispcnt.enable[ENABLE_OBJ]) {
+        RenderLayerOAM(false);
+      }
+      ComposeScanline(0, 2);
+      break;
+    }
+    case 2: {
+      /* BG Mode 2 - 240x160 pixels, RS mode */
+      for (int i = 0; i < 2; i++) {
+        if (render_mmio.dispcnt.enable[2 + i]) {
+          RenderLayerAffine(i);
+        }
+      }
+      if (render_mmio.dispcnt.enable[ENABLE_OBJ]) {
+        RenderLayerOAM(false);
+      }
+      ComposeScanline(2, 3);
+      break;
+    }
+    case 3: {
+      /* BG Mode 3 - 240x160 pixels, 32768 colors */
+      if (render_mmio.dispcnt.enable[2]) {
+        RenderLayerBitmap1();
+      }
+      if (render_mmio.dispcnt.enable[ENABLE_OBJ]) {
+        RenderLayerOAM(true);
+      }
+      ComposeScanline(2, 2);
+      break;
+    }
+    case 4: {
+      /* BG Mode 4 - 240x160 pixels, 256 colors (out of 32768 colors) */
+      if (render_mmio.dispcnt.enable[2]) {
+        RenderLayerBitmap2();
+      }
+      if (render_mmio.dispcnt.enable[ENABLE_OBJ]) {
+        RenderLayerOAM(true);
+      }
+      ComposeScanline(2, 2);
+      break;
+    }
+    case 5: {
+      /* BG Mode 5 - 160x128 pixels, 32768 colors */
+      if (render_mmio.dispcnt.enable[2]) {
+        RenderLayerBitmap3();
+      }
+      if (render_mmio.dispcnt.enable[ENABLE_OBJ]) {
+        RenderLayerOAM(true);
+      }
+      ComposeScanline(2, 2);
+      break;
+    }
+  }
+}
+
+void LineRenderer::ComposeScanline(int bg_min, int bg_max) {
+  auto const& dispcnt = render_mmio.dispcnt;
+  auto const& bgcnt = render_mmio.bgcnt;
+  auto const& bldcnt = render_mmio.bldcnt;
+
+  Compositor::Input input;
+  Compositor::Output selection;
+
+  auto layer_mask = [](int const* enable) {
+    std::uint16_t mask = 0;
+    for (int layer = 0; layer < 6; layer++) {
+      if (enable[layer]) {
+        mask |= 1 << layer;
+      }
+    }
+    return mask;
+  };
+
+  input.bg_count = 0;
+
+  /* Sort enabled backgrounds by their respective priority in ascending order. */
+  for (int prio = 3; prio >= 0; prio--) {
+    for (int bg = bg_max; bg >= bg_min; bg--) {
+      if (dispcnt.enable[bg] && bgcnt[bg].priority == prio) {
+        input.bg_list[input.bg_count++] = bg;
+      }
+    }
+  }
+
+  for (int bg = 0; bg < 4; bg++) {
+    input.bg[bg] = &buffer_bg[bg][s_line_padding];
+    input.bg_priority[bg] = bgcnt[bg].priority;
+  }
+
+  input.obj_enable = dispcnt.enable[ENABLE_OBJ];
+  input.obj_color = buffer_obj.color;
+  input.obj_priority = buffer_obj.priority;
+  input.obj_alpha = buffer_obj.alpha;
+
+  bool no_windows = !dispcnt.enable[ENABLE_WIN0] &&
+                    !dispcnt.enable[ENABLE_WIN1] &&
+                    !dispcnt.enable[ENABLE_OBJWIN];
+
+  bool win_active[3] = {
+    dispcnt.enable[ENABLE_WIN0] && window_scanline_enable[0],
+    dispcnt.enable[ENABLE_WIN1] && window_scanline_enable[1],
+    /* The OBJ window is made of sprites, so it is empty unless OBJs are displayed. */
+    dispcnt.enable[ENABLE_OBJWIN] && dispcnt.enable[ENABLE_OBJ]
+  };
+
+  std::uint16_t win_layers[4] = {
+    layer_mask(render_mmio.winin.enable[0]),
+    layer_mask(render_mmio.winin.enable[1]),
+    layer_mask(render_mmio.winout.enable[1]),
+    no_windows ? std::uint16_t(0x3F) : layer_mask(render_mmio.winout.enable[0])
+  };
+
+  Compositor::SplitWindows(input, win_active, render_mmio.winh, win_layers);
+  input.obj_win_inside = buffer_obj.window;
+
+  input.sfx = bldcnt.sfx;
+  input.sfx_targets[0] = layer_mask(bldcnt.targets[0]);
+  input.sfx_targets[1] = layer_mask(bldcnt.targets[1]);
+
+  Compositor::SelectLayers(input, selection);
+
+  /* In modes 3 and 5 BG2 holds direct colors instead of palette entries. */
+  std::uint16_t direct_color_mask = (dispcnt.mode == 3 || dispcnt.mode == 5) ? (1 << LAYER_BG2) : 0;
+
+  std::uint16_t color[2][240];
+  bool have_sfx = false;
+
+  for (int x = 0; x < 240; x++) {
+    std::uint16_t pixel[2] = { selection.top[x], selection.bottom[x] };
+    bool direct_color[2] = {
+      (selection.top_layer[x] & direct_color_mask) != 0,
+      (selection.bottom_layer[x] & direct_color_mask) != 0
+    };
+
+    color[0][x] = direct_color[0] ? pixel[0] : palette_cache.color15[pixel[0]];
+
+    /* The second color is only needed for pixels modified by a color effect. */
+    if (selection.sfx[x] != BlendMode::SFX_NONE) {
+      color[1][x] = direct_color[1] ? pixel[1] : palette_cache.color15[pixel[1]];
+      have_sfx = true;
+    } else {
+      color[1][x] = 0;
+    }
+  }
+
+  if (have_sfx) {
+    Compositor::BlendLine(color[0], color[1], selection.sfx,
+      std::min(16, render_mmio.eva), std::min(16, render_mmio.evb), std::min(16, render_mmio.evy));
+  }
+
+  /* The whole line is converted to the output format at once. */
+  OutputLine(color[0]);
+}
+
+} // namespace nba::core
@@ -0,0 +1,266 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <algorithm>
+
+#include "compositor.hpp"
+#include "cpu_features.hpp"
+
+namespace nba::core {
+
+using BlendMode = BlendControl::Effect;
+
+#ifdef NBA_X86_SIMD
+
+/* Implemented in compositor_sse41.cpp and compositor_avx2.cpp,
+ * which are the only files built with the respective instruction sets enabled.
+ */
+void SelectLayersSSE41(Compositor::Input const& input, Compositor::Output& output);
+void SelectLayersAVX2(Compositor::Input const& input, Compositor::Output& output);
+void BlendLineSSE41(std::uint16_t* top, std::uint16_t const* bottom, std::uint16_t const* sfx, int eva, int evb, int evy);
+void BlendLineAVX2(std::uint16_t* top, std::uint16_t const* bottom, std::uint16_t const* sfx, int eva, int evb, int evy);
+
+#endif // NBA_X86_SIMD
+
+static void SelectPixel(Compositor::Input const& input, Compositor::Output& output, int x, std::uint16_t layers) {
+  std::uint16_t layer[2] = { Compositor::kLayerBD, Compositor::kLayerBD };
+  std::uint16_t pixel[2] = { 0, 0 };
+  int prio[2] = { 4, 4 };
+
+  /* Find up to two top-most visible background pixels. */
+  for (int i = 0; i < input.bg_count; i++) {
+    int bg = input.bg_list[i];
+    auto pixel_new = input.bg[bg][x];
+
+    if ((layers & (1 << bg)) && pixel_new != Compositor::s_color_transparent) {
+      layer[1] = layer[0];
+      pixel[1] = pixel[0];
+      prio[1] = prio[0];
+      layer[0] = 1 << bg;
+      pixel[0] = pixel_new;
+      prio[0] = input.bg_priority[bg];
+    }
+  }
+
+  bool is_alpha_obj = false;
+
+  /* Check if a OBJ pixel takes priority over one of the two
+   * top-most background pixels and insert it accordingly.
+   */
+  if (input.obj_enable &&
+      input.obj_color[x] != Compositor::s_color_transparent &&
+      (layers & Compositor::kLayerOBJ)) {
+    int priority = input.obj_priority[x];
+
+    if (priority <= prio[0]) {
+      layer[1] = layer[0];
+      pixel[1] = pixel[0];
+      layer[0] = Compositor::kLayerOBJ;
+      pixel[0] = input.obj_color[x];
+      is_alpha_obj = input.obj_alpha[x];
+    } else if (priority <= prio[1]) {
+      layer[1] = Compositor::kLayerOBJ;
+      pixel[1] = input.obj_color[x];
+    }
+  }
+
+  auto sfx = BlendMode::SFX_NONE;
+
+  if ((layers & Compositor::kLayerSFX) || is_alpha_obj) {
+    bool have_dst = layer[0] & input.sfx_targets[0];
+    bool have_src = layer[1] & input.sfx_targets[1];
+
+    if (is_alpha_obj && have_src) {
+      sfx = BlendMode::SFX_BLEND;
+    } else if (have_dst && input.sfx != BlendMode::SFX_NONE && (have_src || input.sfx != BlendMode::SFX_BLEND)) {
+      sfx = input.sfx;
+    }
+  }
+
+  output.top[x] = pixel[0];
+  output.bottom[x] = pixel[1];
+  output.top_layer[x] = layer[0];
+  output.bottom_layer[x] = layer[1];
+  output.sfx[x] = sfx;
+}
+
+static void SelectLayersScalar(Compositor::Input const& input, Compositor::Output& output) {
+  for (int i = 0; i < input.win_span_count; i++) {
+    auto const& span = input.win_spans[i];
+
+    if (span.obj_window) {
+      for (int x = span.first; x < span.last; x++) {
+        SelectPixel(input, output, x, input.obj_win_inside[x] ? input.obj_win_layers : span.layers);
+      }
+    } else {
+      for (int x = span.first; x < span.last; x++) {
+        SelectPixel(input, output, x, span.layers);
+      }
+    }
+  }
+}
+
+static void BlendLineScalar(std::uint16_t* top,
+                            std::uint16_t const* bottom,
+                            std::uint16_t const* sfx,
+                            int eva,
+                            int evb,
+                            int evy) {
+  for (int x = 0; x < 240; x++) {
+    /* Every effect is a weighted sum of the top-most color and a second color. */
+    int factor[2] = { 16, 0 };
+    int color = 0;
+
+    switch (sfx[x]) {
+      case BlendMode::SFX_BLEND:
+        factor[0] = eva;
+        factor[1] = evb;
+        color = bottom[x];
+        break;
+      case BlendMode::SFX_BRIGHTEN:
+        factor[0] = 16 - evy;
+        factor[1] = evy;
+        color = 0x7FFF;
+        break;
+      case BlendMode::SFX_DARKEN:
+        factor[0] = 16 - evy;
+        factor[1] = evy;
+        break;
+    }
+
+    int result = 0;
+
+    for (int shift = 0; shift <= 10; shift += 5) {
+      int channel0 = (top[x] >> shift) & 0x1F;
+      int channel1 = (color  >> shift) & 0x1F;
+
+      result |= std::min((channel0 * factor[0] + channel1 * factor[1]) >> 4, 0x1F) << shift;
+    }
+
+    top[x] = result;
+  }
+}
+
+struct Implementation {
+  decltype(&SelectLayersScalar) select_layers;
+  decltype(&BlendLineScalar) blend_line;
+};
+
+static auto SelectImplementation() -> Implementation {
+#ifdef NBA_X86_SIMD
+  if (HasAVX2()) {
+    return { SelectLayersAVX2, BlendLineAVX2 };
+  }
+
+  if (HasSSE41()) {
+    return { SelectLayersSSE41, BlendLineSSE41 };
+  }
+#endif
+
+  return { SelectLayersScalar, BlendLineScalar };
+}
+
+static auto GetImplementation() -> Implementation const& {
+  static Implementation const implementation = SelectImplementation();
+
+  return implementation;
+}
+
+void Compositor::SplitWindows(Input& input,
+                              bool const win_active[3],
+                              WindowRange const win_range[2],
+                              std::uint16_t const win_layers[4]) {
+  auto inside = [&](int id, int x) {
+    auto const& range = win_range[id];
+
+    if (!win_active[id]) {
+      return false;
+    }
+
+    if (range.min <= range.max) {
+      return x >= range.min && x < range.max;
+    }
+
+    return x >= range.min || x < range.max;
+  };
+
+  /* The window state can only change where one of the windows starts or ends. */
+  int edges[6] = { 0, 240 };
+  int edge_count = 2;
+
+  for (int id = 0; id < 2; id++) {
+    if (win_active[id]) {
+      edges[edge_count++] = std::min(win_range[id].min, 240);
+      edges[edge_count++] = std::min(win_range[id].max, 240);
+    }
+  }
+
+  std::sort(edges, edges + edge_count);
+
+  input.win_span_count = 0;
+
+  for (int i = 1; i < edge_count; i++) {
+    int first = edges[i - 1];
+    int last  = edges[i];
+
+    if (first == last) {
+      continue;
+    }
+
+    WindowSpan span{ first, last, win_layers[3], win_active[2] };
+
+    if (inside(0, first)) {
+      span.layers = win_layers[0];
+      span.obj_window = false;
+    } else if (inside(1, first)) {
+      span.layers = win_layers[1];
+      span.obj_window = false;
+    }
+
+    if (input.win_span_count != 0) {
+      auto& previous = input.win_spans[input.win_span_count - 1];
+
+      if (previous.layers == span.layers && previous.obj_window == span.obj_window) {
+        previous.last = last;
+        continue;
+      }
+    }
+
+    input.win_spans[input.win_span_count++] = span;
+  }
+
+  input.obj_win_layers = win_layers[2];
+}
+
+void Compositor::ExpandWindows(Input const& input, std::uint8_t* layers) {
+  for (int i = 0; i < input.win_span_count; i++) {
+    auto const& span = input.win_spans[i];
+
+    if (span.obj_window) {
+      for (int x = span.first; x < span.last; x++) {
+        layers[x] = input.obj_win_inside[x] ? input.obj_win_layers : span.layers;
+      }
+    } else {
+      std::fill(&layers[span.first], &layers[span.last], std::uint8_t(span.layers));
+    }
+  }
+}
+
+void Compositor::SelectLayers(Input const& input, Output& output) {
+  GetImplementation().select_layers(input, output);
+}
+
+void Compositor::BlendLine(std::uint16_t* top,
+                           std::uint16_t const* bottom,
+                           std::uint16_t const* sfx,
+                           int eva,
+                           int evb,
+                           int evy) {
+  GetImplementation().blend_line(top, bottom, sfx, eva, evb, evy);
+}
+
+} // namespace nba::core
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <emulator/core/hw/ppu/registers.hpp>
+
+namespace nba::core {
+
+/* Layer selection and color effect stages of the scanline compositor.
+ * For every pixel it finds the two top-most visible layers and the color effect
+ * to apply to them. Resolving palette entries to colors is left to the renderer.
+ *
+ * Layers are passed as bit masks, where bit n stands for layer n in the order
+ * BG0 - BG3, OBJ and backdrop (which doubles as the color effect bit in window masks).
+ */
+struct Compositor {
+  static constexpr std::uint16_t kLayerOBJ = 1 << 4;
+  static constexpr std::uint16_t kLayerBD  = 1 << 5;
+  static constexpr std::uint16_t kLayerSFX = 1 << 5;
+
+  static constexpr std::uint16_t s_color_transparent = 0x8000;
+
+  struct WindowSpan {
+    int first;
+    int last;
+    std::uint16_t layers;
+    bool obj_window;
+  };
+
+  struct Input {
+    /// Enabled backgrounds, from the bottom-most to the top-most.
+    int bg_count;
+    int bg_list[4];
+
+    std::uint16_t const* bg[4];
+    std::uint16_t bg_priority[4];
+
+    bool obj_enable;
+    std::uint16_t const* obj_color;
+    std::uint8_t  const* obj_priority;
+    std::uint8_t  const* obj_alpha;
+
+    /// The line split into spans of constant window state, from left to right.
+    /// Within spans marked obj_window, pixels inside the OBJ window show obj_win_layers instead.
+    int win_span_count;
+    WindowSpan win_spans[5];
+
+    std::uint8_t const* obj_win_inside;
+    std::uint16_t obj_win_layers;
+
+    BlendControl::Effect sfx;
+    std::uint16_t sfx_targets[2];
+  };
+
+  struct Output {
+    /// Palette entries (or direct colors) of the two top-most layers.
+    std::uint16_t top[240];
+    std::uint16_t bottom[240];
+
+    std::uint16_t top_layer[240];
+    std::uint16_t bottom_layer[240];
+
+    /// Color effect to apply, as a BlendControl::Effect.
+    std::uint16_t sfx[240];
+  };
+
+  /// Splits the line into the window spans of the input.
+  /// WIN0 and WIN1 cover [min, max) of the line while active and wrap around if min > max.
+  /// win_layers holds the visible layers inside WIN0, WIN1, the OBJ window and outside of all windows.
+  static void SplitWindows(Input& input,
+                           bool const win_active[3],
+                           WindowRange const win_range[2],
+                           std::uint16_t const win_layers[4]);
+
+  /// Writes the visible layers of each pixel, as given by the window spans, to a line of 240 bytes.
+  static void ExpandWindows(Input const& input, std::uint8_t* layers);
+
+  static void SelectLayers(Input const& input, Output& output);
+
+  /// Applies the color effects chosen by SelectLayers to a line of 15-bit colors.
+  /// The top-most colors are replaced by the result, pixels without an effect are kept.
+  /// The coefficients must be in the range 0 - 16.
+  static void BlendLine(std::uint16_t* top,
+                        std::uint16_t const* bottom,
+                        std::uint16_t const* sfx,
+                        int eva,
+                        int evb,
+                        int evy);
+};
+
+} // namespace nba::core
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <immintrin.h>
+
+#include "compositor.hpp"
+
+namespace nba::core {
+
+namespace {
+
+using V = __m256i;
+
+constexpr int kLanes = 16;
+
+inline V Set(int value) { return _mm256_set1_epi16(std::int16_t(value)); }
+inline V Load(std::uint16_t const* data) { return _mm256_loadu_si256((__m256i const*)data); }
+inline V LoadBytes(std::uint8_t const* data) { return _mm256_cvtepu8_epi16(_mm_loadu_si128((__m128i const*)data)); }
+inline void Store(std::uint16_t* data, V value) { _mm256_storeu_si256((__m256i*)data, value); }
+
+inline V And(V a, V b) { return _mm256_and_si256(a, b); }
+inline V Or(V a, V b) { return _mm256_or_si256(a, b); }
+inline V AndNot(V a, V b) { return _mm256_andnot_si256(a, b); }
+inline V Eq(V a, V b) { return _mm256_cmpeq_epi16(a, b); }
+inline V Gt(V a, V b) { return _mm256_cmpgt_epi16(a, b); }
+inline V Select(V mask, V a, V b) { return _mm256_blendv_epi8(b, a, mask); }
+inline V Add(V a, V b) { return _mm256_add_epi16(a, b); }
+inline V Mul(V a, V b) { return _mm256_mullo_epi16(a, b); }
+inline V Min(V a, V b) { return _mm256_min_epu16(a, b); }
+
+template<int n> V ShiftLeft(V value) { return _mm256_slli_epi16(value, n); }
+template<int n> V ShiftRight(V value) { return _mm256_srli_epi16(value, n); }
+
+#include "compositor_simd.inl"
+
+} // namespace
+
+void SelectLayersAVX2(Compositor::Input const& input, Compositor::Output& output) {
+  SelectLayersSIMD(input, output);
+}
+
+void BlendLineAVX2(std::uint16_t* top, std::uint16_t const* bottom, std::uint16_t const* sfx, int eva, int evb, int evy) {
+  BlendLineSIMD(top, bottom, sfx, eva, evb, evy);
+}
+
+} // namespace nba::core
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+/* Vectorized compositor stages, see SelectLayersScalar and BlendLineScalar in compositor.cpp
+ * for the reference. The including file provides the vector type V with kLanes 16-bit lanes
+ * and the operations Set, Load, LoadBytes (zero-extending), Store, And, Or, AndNot (~a & b),
+ * Eq, Gt (signed), Select (mask ? a : b), Add, Mul (low half), Min (unsigned),
+ * ShiftLeft<n> and ShiftRight<n>.
+ */
+void SelectLayersSIMD(Compositor::Input const& input, Compositor::Output& output) {
+  using BlendMode = BlendControl::Effect;
+
+  auto const zero = Set(0);
+  auto const ones = Set(0xFFFF);
+  auto const transparent = Set(Compositor::s_color_transparent);
+  auto const layer_obj = Set(Compositor::kLayerOBJ);
+  auto const layer_sfx = Set(Compositor::kLayerSFX);
+  auto const targets_dst = Set(input.sfx_targets[0]);
+  auto const targets_src = Set(input.sfx_targets[1]);
+
+  auto nonzero = [&](V value) {
+    return AndNot(Eq(value, zero), ones);
+  };
+
+  std::uint8_t win_layers[240];
+
+  Compositor::ExpandWindows(input, win_layers);
+
+  for (int x = 0; x < 240; x += kLanes) {
+    auto layers = LoadBytes(&win_layers[x]);
+
+    V layer0 = Set(Compositor::kLayerBD);
+    V layer1 = layer0;
+    V pixel0 = zero;
+    V pixel1 = zero;
+    V prio0 = Set(4);
+    V prio1 = prio0;
+
+    /* Find up to two top-most visible background pixels. */
+    for (int i = 0; i < input.bg_count; i++) {
+      int bg = input.bg_list[i];
+      auto bit = Set(1 << bg);
+      auto pixel_new = Load(&input.bg[bg][x]);
+      auto visible = AndNot(Eq(pixel_new, transparent), nonzero(And(layers, bit)));
+
+      layer1 = Select(visible, layer0, layer1);
+      pixel1 = Select(visible, pixel0, pixel1);
+      prio1 = Select(visible, prio0, prio1);
+      layer0 = Select(visible, bit, layer0);
+      pixel0 = Select(visible, pixel_new, pixel0);
+      prio0 = Select(visible, Set(input.bg_priority[bg]), prio0);
+    }
+
+    V is_alpha_obj = zero;
+
+    /* Insert the OBJ pixel above or below the top-most background pixel. */
+    if (input.obj_enable) {
+      auto color = Load(&input.obj_color[x]);
+      auto priority = LoadBytes(&input.obj_priority[x]);
+      auto visible = AndNot(Eq(color, transparent), nonzero(And(layers, layer_obj)));
+      auto above0 = AndNot(Gt(priority, prio0), visible);
+      auto above1 = AndNot(Or(above0, Gt(priority, prio1)), visible);
+
+      layer1 = Select(above0, layer0, layer1);
+      pixel1 = Select(above0, pixel0, pixel1);
+      layer0 = Select(above0, layer_obj, layer0);
+      pixel0 = Select(above0, color, pixel0);
+      layer1 = Select(above1, layer_obj, layer1);
+      pixel1 = Select(above1, color, pixel1);
+
+      is_alpha_obj = AndNot(Eq(LoadBytes(&input.obj_alpha[x]), zero), above0);
+    }
+
+    auto have_dst = nonzero(And(layer0, targets_dst));
+    auto have_src = nonzero(And(layer1, targets_src));
+    auto sfx_enable = Or(nonzero(And(layers, layer_sfx)), is_alpha_obj);
+    auto sfx = zero;
+
+    if (input.sfx == BlendMode::SFX_BLEND) {
+      sfx = And(And(have_dst, have_src), Set(input.sfx));
+    } else if (input.sfx != BlendMode::SFX_NONE) {
+      sfx = And(have_dst, Set(input.sfx));
+    }
+
+    sfx = Select(And(is_alpha_obj, have_src), Set(BlendMode::SFX_BLEND), sfx);
+
+    Store(&output.top[x], pixel0);
+    Store(&output.bottom[x], pixel1);
+    Store(&output.top_layer[x], layer0);
+    Store(&output.bottom_layer[x], layer1);
+    Store(&output.sfx[x], And(sfx, sfx_enable));
+  }
+}
+
+void BlendLineSIMD(std::uint16_t* top,
+                   std::uint16_t const* bottom,
+                   std::uint16_t const* sfx,
+                   int eva,
+                   int evb,
+                   int evy) {
+  using BlendMode = BlendControl::Effect;
+
+  auto const channel_mask = Set(0x1F);
+  auto const sfx_blend = Set(BlendMode::SFX_BLEND);
+  auto const sfx_brighten = Set(BlendMode::SFX_BRIGHTEN);
+  auto const sfx_darken = Set(BlendMode::SFX_DARKEN);
+
+  auto blend_channel = [&](V channel0, V channel1, V factor0, V factor1) {
+    return Min(ShiftRight<4>(Add(Mul(channel0, factor0), Mul(channel1, factor1))), channel_mask);
+  };
+
+  for (int x = 0; x < 240; x += kLanes) {
+    auto mode = Load(&sfx[x]);
+    auto is_blend = Eq(mode, sfx_blend);
+    auto is_brighten = Eq(mode, sfx_brighten);
+    auto is_fade = Or(is_brighten, Eq(mode, sfx_darken));
+
+    /* Every effect is a weighted sum of the top-most color and a second color. */
+    auto factor0 = Select(is_blend, Set(eva), Select(is_fade, Set(16 - evy), Set(16)));
+    auto factor1 = Select(is_blend, Set(evb), And(is_fade, Set(evy)));
+    auto color0 = Load(&top[x]);
+    auto color1 = Select(is_blend, Load(&bottom[x]), And(is_brighten, Set(0x7FFF)));
+
+    auto r = blend_channel(And(color0, channel_mask), And(color1, channel_mask), factor0, factor1);
+    auto g = blend_channel(And(ShiftRight<5>(color0), channel_mask), And(ShiftRight<5>(color1), channel_mask), factor0, factor1);
+    auto b = blend_channel(And(ShiftRight<10>(color0), channel_mask), And(ShiftRight<10>(color1), channel_mask), factor0, factor1);
+
+    Store(&top[x], Or(r, Or(ShiftLeft<5>(g), ShiftLeft<10>(b))));
+  }
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <smmintrin.h>
+
+#include "compositor.hpp"
+
+namespace nba::core {
+
+namespace {
+
+using V = __m128i;
+
+constexpr int kLanes = 8;
+
+inline V Set(int value) { return _mm_set1_epi16(std::int16_t(value)); }
+inline V Load(std::uint16_t const* data) { return _mm_loadu_si128((__m128i const*)data); }
+inline V LoadBytes(std::uint8_t const* data) { return _mm_cvtepu8_epi16(_mm_loadl_epi64((__m128i const*)data)); }
+inline void Store(std::uint16_t* data, V value) { _mm_storeu_si128((__m128i*)data, value); }
+
+inline V And(V a, V b) { return _mm_and_si128(a, b); }
+inline V Or(V a, V b) { return _mm_or_si128(a, b); }
+inline V AndNot(V a, V b) { return _mm_andnot_si128(a, b); }
+inline V Eq(V a, V b) { return _mm_cmpeq_epi16(a, b); }
+inline V Gt(V a, V b) { return _mm_cmpgt_epi16(a, b); }
+inline V Select(V mask, V a, V b) { return _mm_blendv_epi8(b, a, mask); }
+inline V Add(V a, V b) { return _mm_add_epi16(a, b); }
+inline V Mul(V a, V b) { return _mm_mullo_epi16(a, b); }
+inline V Min(V a, V b) { return _mm_min_epu16(a, b); }
+
+template<int n> V ShiftLeft(V value) { return _mm_slli_epi16(value, n); }
+template<int n> V ShiftRight(V value) { return _mm_srli_epi16(value, n); }
+
+#include "compositor_simd.inl"
+
+} // namespace
+
+void SelectLayersSSE41(Compositor::Input const& input, Compositor::Output& output) {
+  SelectLayersSIMD(input, output);
+}
+
+void BlendLineSSE41(std::uint16_t* top, std::uint16_t const* bottom, std::uint16_t const* sfx, int eva, int evb, int evy) {
+  BlendLineSIMD(top, bottom, sfx, eva, evb, evy);
+}
+
+} // namespace nba::core
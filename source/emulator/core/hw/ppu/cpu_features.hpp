@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#ifdef NBA_X86_SIMD
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace nba::core {
+
+/* Detection of the instruction sets used by the SIMD rendering kernels.
+ * These are built into separate files and only called if the host CPU supports them.
+ */
+#ifdef _MSC_VER
+
+inline bool HasSSE41() {
+  int info[4];
+  __cpuid(info, 1);
+  return info[2] & (1 << 19);
+}
+
+inline bool HasAVX2() {
+  int info[4];
+  __cpuid(info, 1);
+
+  // The OS must save the upper halves of the YMM registers on context switches.
+  bool os_saves_ymm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+
+  __cpuidex(info, 7, 0);
+  return os_saves_ymm && (info[1] & (1 << 5));
+}
+
+#else
+
+inline bool HasSSE41() { return __builtin_cpu_supports("sse4.1"); }
+inline bool HasAVX2() { return __builtin_cpu_supports("avx2"); }
+
+#endif
+
+} // namespace nba::core
+
+#endif // NBA_X86_SIMD
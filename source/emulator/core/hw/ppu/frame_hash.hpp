@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace nba::core {
+
+/* Detects frames that are identical to the previously presented frame,
+ * by comparing a 64-bit hash of the whole output.
+ */
+struct FrameHash {
+  void Reset() { valid = false; }
+
+  /// Returns true if the frame differs from the last one passed in since the reset.
+  bool Update(std::uint32_t const* output) {
+    auto new_hash = Hash(output);
+    bool changed = !valid || new_hash != hash;
+
+    hash = new_hash;
+    valid = true;
+    return changed;
+  }
+
+private:
+  static auto Hash(std::uint32_t const* output) -> std::uint64_t {
+    static constexpr std::uint64_t s_prime = 0x9E3779B97F4A7C15;
+
+    /* Four independent lanes, so that the multiplications can overlap. */
+    std::uint64_t lanes[4] = { 1, 2, 3, 4 };
+
+    for (int i = 0; i < 240 * 160; i += 8) {
+      for (int j = 0; j < 4; j++) {
+        std::uint64_t word;
+        std::memcpy(&word, &output[i + j * 2], sizeof(word));
+        lanes[j] = (lanes[j] ^ word) * s_prime;
+        lanes[j] ^= lanes[j] >> 29;
+      }
+    }
+
+    return ((lanes[0] * s_prime + lanes[1]) * s_prime + lanes[2]) * s_prime + lanes[3];
+  }
+
+  bool valid = false;
+  std::uint64_t hash;
+};
+
+} // namespace nba::core
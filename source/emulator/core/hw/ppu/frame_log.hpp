@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <emulator/core/hw/ppu/ppu.hpp>
+#include <emulator/core/hw/ppu/render_thread.hpp>
+#include <vector>
+
+namespace nba::core {
+
+/* Record of everything the scanline renderer depends on during one frame:
+ * the PPU registers of each visible line, and the writes to video memory in between.
+ * Any range of lines can be rendered from it, given video memory as of the frame start.
+ */
+struct FrameLog {
+  using Memory = RenderThread::Memory;
+
+  struct Write {
+    Memory memory;
+    std::uint32_t address;
+    std::uint32_t size;
+
+    /// Offset of the written bytes in the data buffer.
+    std::size_t offset;
+
+    /// Number of lines recorded before the write, i.e. the first line that sees it.
+    int line;
+  };
+
+  void Clear() {
+    writes.clear();
+    data.clear();
+    line_count = 0;
+  }
+
+  void RecordWrite(Memory memory, std::uint32_t address, std::uint8_t const* bytes, std::uint32_t size) {
+    writes.push_back({ memory, address, size, data.size(), line_count });
+    data.insert(data.end(), bytes, bytes + size);
+  }
+
+  void RecordLine(PPU::MMIO const& mmio) {
+    if (line_count < 160) {
+      lines[line_count++] = mmio;
+    }
+  }
+
+  std::vector<Write> writes;
+  std::vector<std::uint8_t> data;
+
+  PPU::MMIO lines[160];
+  int line_count = 0;
+};
+
+} // namespace nba::core
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "frame_renderer.hpp"
+
+namespace nba::core {
+
+FrameRenderer::FrameRenderer(Scheduler* scheduler,
+         InterruptController* irq_controller,
+         DMA* dma,
+         std::shared_ptr<Config> config,
+         common::MemoryArena& arena,
+         PixelFormat pixel_format)
+  : nba::core::PPU(scheduler, irq_controller, dma, arena)
+  , config(config)
+  , pixel_format(pixel_format)
+  , frame_buffer(std::make_shared<VideoDevice::FrameBuffer>())
+  , output(frame_buffer->Back().data())
+  , previous_output(output)
+{
+  if (config->video.frame_threads > 0) {
+    frame_log = std::make_unique<FrameLog>();
+    frame_pool = std::make_unique<common::ThreadPool>(config->video.frame_threads);
+
+    for (int i = 0; i < frame_pool->Size(); i++) {
+      line_renderers.push_back(std::make_unique<LineRenderer>(*this, output, pixel_format, config->video.color_correction, true));
+    }
+  } else {
+    line_renderers.push_back(std::make_unique<LineRenderer>(
+      *this, output, pixel_format, config->video.color_correction, config->video.render_thread));
+
+    if (config->video.render_thread) {
+      auto& line_renderer = *line_renderers[0];
+
+      render_thread = std::make_unique<RenderThread>(
+        [&](RenderThread::Memory memory, std::uint32_t address, std::uint8_t const* data, std::uint32_t size) {
+          line_renderer.Write(memory, address, data, size);
+        },
+        [&](MMIO const& registers) {
+          line_renderer.LoadRegisters(registers);
+          line_renderer.RenderScanline();
+        }
+      );
+    }
+  }
+
+  if (config->video.reuse_lines) {
+    line_tracker = std::make_unique<LineTracker>(pixel_format);
+  }
+
+  config->video_dev->SetFrameBuffer(frame_buffer);
+
+  Reset();
+}
+
+void FrameRenderer::Reset() {
+  if (render_thread) {
+    render_thread->Wait();
+  }
+
+  PPU::Reset();
+
+  for (auto& line_renderer : line_renderers) {
+    line_renderer->Reset(*this);
+  }
+
+  if (frame_log) {
+    frame_log->Clear();
+  }
+
+  if (line_tracker) {
+    line_tracker->Reset(*this);
+  }
+
+  frame_skipper.Reset();
+  frame_hash.Reset();
+  skip_frame = false;
+}
+
+void FrameRenderer::SubmitScanline() {
+  if (skip_frame) {
+    return;
+  }
+
+  /* The row from the last time the line was rendered is still valid. */
+  if (line_tracker && line_tracker->Reuse(mmio)) {
+    auto row_size = 240 * BytesPerPixel(pixel_format);
+    auto offset = mmio.vcount * row_size;
+
+    /* Until the first frame is published, both are the same buffer. */
+    if (output != previous_output) {
+      std::memcpy((std::uint8_t*)output + offset, (std::uint8_t*)previous_output + offset, row_size);
+    }
+    return;
+  }
+
+  if (frame_log) {
+    frame_log->RecordLine(mmio);
+  } else if (render_thread) {
+    render_thread->SubmitLine(mmio);
+  } else {
+    line_renderers[0]->LoadRegisters(mmio);
+    line_renderers[0]->RenderScanline();
+  }
+}
+
+void FrameRenderer::SubmitFrame() {
+  /* The frame is complete once the render thread caught up. */
+  if (render_thread) {
+    render_thread->Wait();
+  }
+
+  if (frame_log) {
+    RenderFrame();
+  }
+
+  /* A skipped frame leaves the output as it is, so the line tracker does not look at it. */
+  if (!skip_frame) {
+    /* If every row was kept, the frame cannot have changed and need not be hashed. */
+    bool changed = true;
+
+    if (line_tracker) {
+      changed = line_tracker->EndFrame(output);
+    }
+
+    changed = changed && frame_hash.Update(output);
+
+    PublishFrame();
+    Draw(previous_output, changed);
+  }
+
+  /* Decided here, so that the lines of a skipped frame are never submitted. */
+  skip_frame = frame_skipper.SkipNextFrame(config->video);
+}
+
+void FrameRenderer::RenderFrame() {
+  int chunk_count = int(line_renderers.size());
+  int chunk_size = (frame_log->line_count + chunk_count - 1) / chunk_count;
+
+  frame_pool->Run(chunk_count, [&](int chunk) {
+    int first_line = std::min(chunk * chunk_size, frame_log->line_count);
+    int last_line = std::min(first_line + chunk_size, frame_log->line_count);
+
+    line_renderers[chunk]->RenderFromLog(*frame_log, first_line, last_line);
+  });
+
+  frame_log->Clear();
+}
+
+void FrameRenderer::PublishFrame() {
+  previous_output = output;
+  output = frame_buffer->Publish().data();
+
+  for (auto& line_renderer : line_renderers) {
+    line_renderer->output = output;
+  }
+}
+
+} // namespace nba::core
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <common/thread_pool.hpp>
+#include <emulator/config/config.hpp>
+#include <emulator/core/hw/dma.hpp>
+#include <emulator/core/scheduler.hpp>
+#include <emulator/core/hw/ppu/ppu.hpp>
+#include <emulator/core/hw/ppu/frame_hash.hpp>
+#include <emulator/core/hw/ppu/frame_log.hpp>
+#include <emulator/core/hw/ppu/frame_skipper.hpp>
+#include <emulator/core/hw/ppu/line_renderer.hpp>
+#include <emulator/core/hw/ppu/line_tracker.hpp>
+#include <emulator/core/hw/ppu/pixel_format.hpp>
+#include <emulator/core/hw/ppu/render_thread.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nba::core {
+
+/* Renders each frame line by line into a frame buffer and publishes it once complete.
+ * Depending on the configuration, lines are rendered synchronously, on a render thread
+ * or in parallel chunks at the end of the frame. Renderers only implement how a published frame is drawn.
+ */
+class FrameRenderer : public nba::core::PPU {
+public:
+  FrameRenderer(Scheduler* scheduler,
+      InterruptController* irq_controller,
+      DMA* dma,
+      std::shared_ptr<Config> config,
+      common::MemoryArena& arena,
+      PixelFormat pixel_format);
+    virtual ~FrameRenderer() override = default;
+
+  virtual void Reset() override;
+
+  void HookPRAM(std::uint32_t address, std::uint32_t size) {
+    SubmitWrite(RenderThread::Memory::PRAM, address, &pram[address], size);
+  }
+
+  void HookVRAM(std::uint32_t address, std::uint32_t size) {
+    SubmitWrite(RenderThread::Memory::VRAM, address, &vram[address], size);
+  }
+
+  void HookOAM(std::uint32_t address, std::uint32_t size) {
+    SubmitWrite(RenderThread::Memory::OAM, address, &oam[address], size);
+  }
+
+protected:
+  /// Draws a published frame. Unless changed is set, it is identical to the previously drawn frame.
+  virtual void Draw(std::uint32_t* frame, bool changed) = 0;
+
+  std::shared_ptr<Config> config;
+
+  /* The format in which frames are rendered. */
+  PixelFormat pixel_format;
+
+private:
+  void SubmitWrite(RenderThread::Memory memory, std::uint32_t address, std::uint8_t const* data, std::uint32_t size) {
+    if (line_tracker && !line_tracker->Write(memory, address, data, size)) {
+      return;
+    }
+
+    if (frame_log) {
+      frame_log->RecordWrite(memory, address, data, size);
+    } else if (render_thread) {
+      render_thread->SubmitWrite(memory, address, data, size);
+    } else {
+      line_renderers[0]->Invalidate(memory, address, size);
+    }
+  }
+
+  void SubmitScanline() override;
+  void SubmitFrame() override;
+  void RenderFrame();
+  void PublishFrame();
+
+  /* Lines are rendered to the back buffer of the frame buffer. The previously published frame
+   * is not written to until the next frame is published, so that reused rows can be copied from it.
+   */
+  std::shared_ptr<VideoDevice::FrameBuffer> frame_buffer;
+  std::uint32_t* output;
+  std::uint32_t* previous_output;
+
+  FrameSkipper frame_skipper;
+  FrameHash frame_hash;
+
+  /* Set if the current frame is neither rendered nor presented. */
+  bool skip_frame;
+
+  /* A single line renderer, unless frames are rendered in parallel chunks. */
+  std::vector<std::unique_ptr<LineRenderer>> line_renderers;
+
+  std::unique_ptr<FrameLog> frame_log;
+  std::unique_ptr<LineTracker> line_tracker;
+  std::unique_ptr<common::ThreadPool> frame_pool;
+
+  /* Declared last, so that the thread is stopped before anything it uses is destroyed. */
+  std::unique_ptr<RenderThread> render_thread;
+};
+
+} // namespace nba::core
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <emulator/config/config.hpp>
+
+namespace nba::core {
+
+/* Decides which frames are rendered and presented.
+ * With a fixed frameskip of N, only one of every N + 1 frames is rendered.
+ * In auto mode, up to N frames in a row are skipped while the emulation is more than
+ * a frame behind real time. Skipped frames still run the PPU timing; they are just not drawn.
+ */
+class FrameSkipper {
+public:
+  void Reset() {
+    skipped = 0;
+    deadline = Clock::now();
+  }
+
+  /// Called once a frame is complete, decides whether the next frame is skipped.
+  bool SkipNextFrame(Config::Video const& video) {
+    bool skip = false;
+
+    if (video.frameskip > 0) {
+      skip = video.frameskip_auto ? Behind() : true;
+
+      if (skipped == video.frameskip) {
+        skip = false;
+      }
+    }
+
+    skipped = skip ? skipped + 1 : 0;
+    return skip;
+  }
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  /* 280896 cycles at 16.78 MHz. */
+  static constexpr Clock::duration s_frame_interval = std::chrono::nanoseconds{16742706};
+
+  /* Lag after which the schedule is restarted rather than caught up with, e.g. after a pause. */
+  static constexpr Clock::duration s_max_lag = std::chrono::seconds{1};
+
+  bool Behind() {
+    auto now = Clock::now();
+
+    deadline += s_frame_interval;
+
+    /* Running ahead of real time (e.g. fast-forward) must not bank time for later. */
+    if (now - deadline > s_max_lag || deadline - now > s_frame_interval) {
+      deadline = now;
+    }
+
+    return now - deadline > s_frame_interval;
+  }
+
+  int skipped = 0;
+  Clock::time_point deadline = Clock::now();
+};
+
+} // namespace nba::core
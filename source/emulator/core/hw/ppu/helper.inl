@@ -5,126 +5,151 @@
  * Refer to the included LICENSE file.
  */
 
-auto ReadPalette(int palette, int index) -> std::uint16_t {
-  int cell = (palette * 32) + (index * 2);
-
-  /* TODO: On Little-Endian devices we can get away with casting to uint16_t*. */
-  return ((pram[cell + 1] << 8) |
-           pram[cell + 0]) & 0x7FFF;
-}
-
+/* Tile decoding yields palette entry numbers (0 - 511) rather than colors.
+ * These are resolved through the palette cache during composition.
+ */
 void DecodeTileLine4BPP(std::uint16_t* buffer, std::uint32_t base, int palette, int number, int y, bool flip) {
-  std::uint8_t* data = &vram[base + (number * 32) + (y * 4)];
-
-  if (flip) {
-    for (int x = 0; x < 4; x++) {
-      int d  = *data++;
-      int p1 = d & 15;
-      int p2 = d >> 4;
-
-      buffer[(x*2+0)^7] = p1 ? ReadPalette(palette, p1) : s_color_transparent;
-      buffer[(x*2+1)^7] = p2 ? ReadPalette(palette, p2) : s_color_transparent;
-    }
-  } else {
-    for (int x = 0; x < 4; x++) {
-      int d  = *data++;
-      int p1 = d & 15;
-      int p2 = d >> 4;
-
-      buffer[x*2+0] = p1 ? ReadPalette(palette, p1) : s_color_transparent;
-      buffer[x*2+1] = p2 ? ReadPalette(palette, p2) : s_color_transparent;
-    }
-  }
+  ExpandTileLine(buffer, &tile_cache.GetTile4BPP(base + (number * 32))[y * 8], palette * 16, flip);
 }
 
-void DecodeTileLine8BPP(std::uint16_t* buffer, std::uint32_t base, int number, int y, bool flip) {
-  std::uint8_t* data = &vram[base + (number * 64) + (y * 8)];
-
-  if (flip) {
-    for (int x = 7; x >= 0; x--) {
-      int pixel = *data++;
-      buffer[x] = pixel ? ReadPalette(0, pixel) : s_color_transparent;
-    }
-  } else {
-    for (int x = 0; x < 8; x++) {
-      int pixel = *data++;
-      buffer[x] = pixel ? ReadPalette(0, pixel) : s_color_transparent;
-    }
-  }
+void DecodeTileLine8BPP(std::uint16_t* buffer, std::uint32_t base, int number, int y, bool flip, bool sprite = false) {
+  ExpandTileLine(buffer, &render_vram[base + (number * 64) + (y * 8)], sprite ? 256 : 0, flip);
 }
 
 auto DecodeTilePixel4BPP(std::uint32_t base, int palette, int number, int x, int y) -> std::uint16_t {
-  std::uint32_t offset = base + (number * 32) + (y * 4) + (x / 2);
-
-  int tuple = vram[offset];
-  int index = (x & 1) ? (tuple >> 4) : (tuple & 0xF);
+  int index = tile_cache.GetTile4BPP(base + (number * 32))[y * 8 + x];
 
   if (index == 0) {
     return s_color_transparent;
   } else {
-    return ReadPalette(palette, index);
+    return palette * 16 + index;
   }
 }
 
 auto DecodeTilePixel8BPP(std::uint32_t base, int number, int x, int y, bool sprite = false) -> std::uint16_t {
   std::uint32_t offset = base + (number * 64) + (y * 8) + x;
 
-  int index = vram[offset];
+  int index = render_vram[offset];
 
   if (index == 0) {
     return s_color_transparent;
   } else {
-    return ReadPalette(sprite ? 16 : 0, index);
+    return sprite ? (256 + index) : index;
+  }
+}
+
+/* Affine backgrounds and the bitmap modes sample their texture along the line
+ * (ref_x, ref_y) + t * (pa, pc). With mosaic, only one pixel per block of mosaic.size_x pixels
+ * is sampled and then stretched over the block.
+ *
+ * sample(buffer, count, ref_x, ref_y, dx, dy, wraparound) samples count pixels into the buffer.
+ * Unless the background wraps around, these are known to lie within the width x height texture.
+ */
+template<typename Sample>
+void AffineRenderLoop(int id, int width, int height, Sample&& sample) {
+  auto const& bg = render_mmio.bgcnt[2 + id];
+  auto const& mosaic = render_mmio.mosaic.bg;
+  std::uint16_t* buffer = &buffer_bg[2 + id][s_line_padding];
+
+  std::int32_t ref_x = render_mmio.bgx[id]._current;
+  std::int32_t ref_y = render_mmio.bgy[id]._current;
+  std::int32_t dx = render_mmio.bgpa[id];
+  std::int32_t dy = render_mmio.bgpc[id];
+
+  int count = 240;
+  int block = 1;
+
+  if (bg.mosaic_enable && mosaic.size_x > 1) {
+    block = mosaic.size_x;
+    count = (240 + block - 1) / block;
+    dx *= block;
+    dy *= block;
+  }
+
+  if (bg.wraparound) {
+    sample(buffer, count, ref_x, ref_y, dx, dy, true);
+  } else {
+    auto span = AffineKernel::VisibleSpan(ref_x, ref_y, dx, dy, count, width, height);
+
+    std::fill(buffer, buffer + span.first, s_color_transparent);
+    std::fill(buffer + span.last, buffer + count, s_color_transparent);
+
+    sample(&buffer[span.first],
+           span.last - span.first,
+           ref_x + span.first * dx,
+           ref_y + span.first * dy,
+           dx,
+           dy,
+           false);
+  }
+
+  /* Stretch the samples over the mosaic blocks, back to front so that none is overwritten early. */
+  if (block > 1) {
+    for (int x = 239; x >= 0; x--) {
+      buffer[x] = buffer[x / block];
+    }
+  }
+}
+
+template<int size>
+static auto WrapCoordinate(int value) -> int {
+  if constexpr ((size & (size - 1)) == 0) {
+    return value & (size - 1);
+  } else {
+    value %= size;
+    return value < 0 ? (value + size) : value;
   }
 }
 
-void AffineRenderLoop(int id,
-                      int width,
-                      int height,
-                      std::function<void(int, int, int)> render_func) {
-  auto const& bg = mmio.bgcnt[2 + id];
-  auto const& mosaic = mmio.mosaic.bg;
-  std::uint16_t* buffer = buffer_bg[2 + id];
-  
-  std::int32_t ref_x = mmio.bgx[id]._current;
-  std::int32_t ref_y = mmio.bgy[id]._current;
-  std::int16_t pa = mmio.bgpa[id];
-  std::int16_t pc = mmio.bgpc[id];
-  
-  int mosaic_x = 0;
-  
-  for (int _x = 0; _x < 240; _x++) {
-    std::int32_t x = ref_x >> 8;
-    std::int32_t y = ref_y >> 8;
-    
-    if (bg.mosaic_enable) {
-      if (++mosaic_x == mosaic.size_x) {
-        ref_x += mosaic.size_x * pa;
-        ref_y += mosaic.size_x * pc;
-        mosaic_x = 0;
+/// Renders a bitmap of width x height pixels, where fetch(x, y) reads the pixel at (x, y)
+/// and fetch_run(buffer, x, y, count) reads count pixels of row y, starting at (x, y).
+template<int width, int height, typename Fetch, typename FetchRun>
+void AffineRenderBitmap(Fetch&& fetch, FetchRun&& fetch_run) {
+  AffineRenderLoop(0, width, height, [&](std::uint16_t* buffer,
+                                         int count,
+                                         std::int32_t ref_x,
+                                         std::int32_t ref_y,
+                                         std::int32_t dx,
+                                         std::int32_t dy,
+                                         bool wraparound) {
+    /* Without rotation or scaling along the line, the samples are consecutive pixels of one row.
+     * Lines with horizontal mosaic never get here, as their step spans a whole mosaic block,
+     * but they take only one sample per block anyway.
+     */
+    if (dx == 0x100 && dy == 0) {
+      int x = ref_x >> 8;
+      int y = ref_y >> 8;
+
+      if (wraparound) {
+        x = WrapCoordinate<width>(x);
+        y = WrapCoordinate<height>(y);
+
+        while (count > 0) {
+          int run = std::min(count, width - x);
+
+          fetch_run(buffer, x, y, run);
+          buffer += run;
+          count -= run;
+          x = 0;
+        }
+      } else if (count > 0) {
+        fetch_run(buffer, x, y, count);
       }
-    } else {
-      ref_x += pa;
-      ref_y += pc;
+      return;
     }
-    
-    if (bg.wraparound) {
-      if (x >= width) {
-        x %= width;
-      } else if (x < 0) {
-        x = width + (x % width);
+
+    if (wraparound) {
+      for (int i = 0; i < count; i++) {
+        buffer[i] = fetch(WrapCoordinate<width>(ref_x >> 8), WrapCoordinate<height>(ref_y >> 8));
+        ref_x += dx;
+        ref_y += dy;
       }
-      
-      if (y >= height) {
-        y %= height;
-      } else if (y < 0) {
-        y = height + (y % height);
+    } else {
+      for (int i = 0; i < count; i++) {
+        buffer[i] = fetch(ref_x >> 8, ref_y >> 8);
+        ref_x += dx;
+        ref_y += dy;
       }
-    } else if (x >= width || y >= height || x < 0 || y < 0) {
-      buffer[_x] = s_color_transparent;
-      continue;
     }
-    
-    render_func(_x, (int)x, (int)y);
-  }
+  });
 }
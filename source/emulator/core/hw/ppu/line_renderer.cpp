@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <cstring>
+
+#include "line_renderer.hpp"
+
+namespace nba::core {
+
+constexpr std::uint16_t LineRenderer::s_color_transparent;
+
+LineRenderer::LineRenderer(PPU& ppu,
+         std::uint32_t* output,
+         PixelFormat format,
+         bool color_correction,
+         bool replicate)
+  : replica(replicate ? new std::uint8_t[0x1C800]() : nullptr)
+  , render_pram(replica ? &replica[0x00000] : ppu.pram)
+  , render_oam(replica ? &replica[0x00400] : ppu.oam)
+  , render_vram(replica ? &replica[0x00800] : ppu.vram)
+  , output(output)
+  , format(format)
+  , color_table(color_correction ? ColorCorrection::Table() : nullptr)
+{ }
+
+void LineRenderer::Reset(PPU const& ppu) {
+  if (replica) {
+    std::memcpy(render_pram, ppu.pram, 0x00400);
+    std::memcpy(render_oam, ppu.oam, 0x00400);
+    std::memcpy(render_vram, ppu.vram, 0x18000);
+  }
+
+  render_mmio = ppu.mmio;
+  tile_cache.Invalidate();
+  palette_cache.Invalidate();
+  object_bins.Invalidate();
+}
+
+void LineRenderer::LoadRegisters(MMIO const& registers) {
+  render_mmio = registers;
+}
+
+void LineRenderer::Write(RenderThread::Memory memory,
+                         std::uint32_t address,
+                         std::uint8_t const* data,
+                         std::uint32_t size) {
+  switch (memory) {
+    case RenderThread::Memory::PRAM:
+      std::memcpy(&render_pram[address], data, size);
+      break;
+    case RenderThread::Memory::OAM:
+      std::memcpy(&render_oam[address], data, size);
+      break;
+    case RenderThread::Memory::VRAM:
+      std::memcpy(&render_vram[address], data, size);
+      break;
+  }
+
+  Invalidate(memory, address, size);
+}
+
+void LineRenderer::RenderFromLog(FrameLog const& log, int first_line, int last_line) {
+  auto write = log.writes.begin();
+
+  auto apply_writes = [&](int line) {
+    for (; write != log.writes.end() && write->line <= line; ++write) {
+      Write(write->memory, write->address, &log.data[write->offset], write->size);
+    }
+  };
+
+  for (int line = first_line; line < last_line; line++) {
+    apply_writes(line);
+    LoadRegisters(log.lines[line]);
+    RenderScanline();
+  }
+
+  /* Catch up with the end of the frame, where the next frame continues from. */
+  apply_writes(log.line_count);
+}
+
+} // namespace nba::core
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <emulator/core/hw/ppu/ppu.hpp>
+#include <emulator/core/hw/ppu/affine_kernel.hpp>
+#include <emulator/core/hw/ppu/bitmap_line.hpp>
+#include <emulator/core/hw/ppu/color_correction.hpp>
+#include <emulator/core/hw/ppu/compositor.hpp>
+#include <emulator/core/hw/ppu/frame_log.hpp>
+#include <emulator/core/hw/ppu/object_bins.hpp>
+#include <emulator/core/hw/ppu/palette_cache.hpp>
+#include <emulator/core/hw/ppu/pixel_format.hpp>
+#include <emulator/core/hw/ppu/registers.hpp>
+#include <emulator/core/hw/ppu/render_thread.hpp>
+#include <emulator/core/hw/ppu/tile_cache.hpp>
+#include <emulator/core/hw/ppu/tile_line.hpp>
+#include <cstdint>
+#include <memory>
+
+namespace nba::core {
+
+/* Renders scanlines from its own copy of the PPU registers.
+ * Video memory is read from the live memory, unless the lines are rendered on
+ * another thread, in which case a private replica is kept up to date through Write().
+ */
+struct LineRenderer {
+  using MMIO = PPU::MMIO;
+
+  LineRenderer(PPU& ppu, std::uint32_t* output, PixelFormat format, bool color_correction, bool replicate);
+
+  void Reset(PPU const& ppu);
+  void LoadRegisters(MMIO const& registers);
+  void Write(RenderThread::Memory memory, std::uint32_t address, std::uint8_t const* data, std::uint32_t size);
+
+  /// Updates the caches after a write to video memory.
+  void Invalidate(RenderThread::Memory memory, std::uint32_t address, std::uint32_t size) {
+    switch (memory) {
+      case RenderThread::Memory::PRAM:
+        palette_cache.Update(address, size);
+        break;
+      case RenderThread::Memory::VRAM:
+        tile_cache.Invalidate(address, size);
+        break;
+      case RenderThread::Memory::OAM:
+        object_bins.Update(address, size);
+        break;
+    }
+  }
+
+  /// Renders a range of lines from a frame log, then applies the remaining writes.
+  void RenderFromLog(FrameLog const& log, int first_line, int last_line);
+
+  void RenderScanline();
+
+  enum ObjAttribute {
+    OBJ_IS_ALPHA  = 1,
+    OBJ_IS_WINDOW = 2
+  };
+
+  enum ObjectMode {
+    OBJ_NORMAL = 0,
+    OBJ_SEMI   = 1,
+    OBJ_WINDOW = 2,
+    OBJ_PROHIBITED = 3
+  };
+
+  enum Layer {
+    LAYER_BG0 = 0,
+    LAYER_BG1 = 1,
+    LAYER_BG2 = 2,
+    LAYER_BG3 = 3,
+    LAYER_OBJ = 4,
+    LAYER_SFX = 5,
+    LAYER_BD  = 5
+  };
+
+  enum Enable {
+    ENABLE_BG0 = 0,
+    ENABLE_BG1 = 1,
+    ENABLE_BG2 = 2,
+    ENABLE_BG3 = 3,
+    ENABLE_OBJ = 4,
+    ENABLE_WIN0 = 5,
+    ENABLE_WIN1 = 6,
+    ENABLE_OBJWIN = 7
+  };
+
+  void RenderLayerText(int id);
+  template<bool full_palette, bool wide>
+  void RenderLayerTextLine(std::uint16_t* buffer, std::uint32_t map_base, std::uint32_t tile_base, int scroll_x, int tile_y);
+  void RenderLayerAffine(int id);
+  void RenderLayerBitmap1();
+  void RenderLayerBitmap2();
+  void RenderLayerBitmap3();
+  void RenderLayerOAM(bool bitmap_mode);
+  void RenderWindow(int id);
+
+  void ComposeScanline(int bg_min, int bg_max);
+
+  #include <emulator/core/hw/ppu/helper.inl>
+
+  /* The replica holds PRAM, OAM and VRAM. VRAM comes last and is followed by zeroes,
+   * as 8BPP tiles may be fetched past its end.
+   */
+  std::unique_ptr<std::uint8_t[]> replica;
+  std::uint8_t* render_pram;
+  std::uint8_t* render_oam;
+  std::uint8_t* render_vram;
+  MMIO render_mmio;
+
+  TileCache tile_cache{render_vram};
+  PaletteCache palette_cache{render_pram};
+  ObjectBins object_bins{render_oam};
+
+  /* Text backgrounds are drawn in whole tiles, so the background lines start
+   * s_line_padding entries in and leave as much room after them, for a partial tile on either side.
+   */
+  static constexpr int s_line_padding = 8;
+
+  std::uint16_t buffer_bg[4][s_line_padding + 240 + s_line_padding];
+
+  /* Stored as separate arrays so that the compositor can load them as vectors. */
+  struct ObjectBuffer {
+    std::uint16_t color[240];
+    std::uint8_t  priority[240];
+    std::uint8_t  alpha[240];
+    std::uint8_t  window[240];
+  } buffer_obj;
+
+  bool line_contains_alpha_obj;
+
+  bool window_scanline_enable[2];
+
+  /// Converts a line of 15-bit colors into the row of the current line.
+  void OutputLine(std::uint16_t const* colors) {
+    auto line = reinterpret_cast<std::uint8_t*>(output) + render_mmio.vcount * 240 * BytesPerPixel(format);
+
+    if (color_table) {
+      ConvertLine(format, color_table, colors, line);
+    } else {
+      ConvertLine(format, colors, line);
+    }
+  }
+
+  std::uint32_t* output;
+  PixelFormat format;
+
+  /* Corrected colors, if the colors of the LCD are emulated. */
+  std::uint32_t const* color_table;
+
+  static constexpr std::uint16_t s_color_transparent = 0x8000;
+  static const int s_obj_size[4][4][2];
+};
+
+} // namespace nba::core
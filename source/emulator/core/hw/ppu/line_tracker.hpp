@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <emulator/core/hw/ppu/ppu.hpp>
+#include <emulator/core/hw/ppu/render_thread.hpp>
+#include <emulator/device/video_device.hpp>
+#include <iterator>
+#include <memory>
+
+#if defined(NBA_CHECK_LINE_REUSE)
+#include <common/log.hpp>
+#endif
+
+namespace nba::core {
+
+/* Tracks whether the inputs of each scanline changed since the line was last rendered,
+ * so that its row of the output can be kept as is.
+ *
+ * A line is reused only if its register snapshot is bitwise identical and neither PRAM,
+ * VRAM nor (with OBJs enabled) OAM changed in between. Writes are compared against a shadow
+ * copy of video memory, so rewriting the same data (e.g. OAM DMA every VBlank) is not a change.
+ *
+ * With NBA_CHECK_LINE_REUSE defined, reusable lines are rendered anyway
+ * and any difference to the kept row is reported.
+ */
+struct LineTracker {
+  using Memory = RenderThread::Memory;
+
+  LineTracker(PixelFormat format) : shadow(new std::uint8_t[0x18800]) {
+#if defined(NBA_CHECK_LINE_REUSE)
+    row_size = 240 * BytesPerPixel(format);
+#else
+    (void)format;
+#endif
+  }
+
+  void Reset(PPU const& ppu) {
+    std::memcpy(&shadow[0x00000], ppu.pram, 0x00400);
+    std::memcpy(&shadow[0x00400], ppu.oam, 0x00400);
+    std::memcpy(&shadow[0x00800], ppu.vram, 0x18000);
+
+    for (auto& line : lines) {
+      line.valid = false;
+    }
+
+    frame_changed = true;
+
+#if defined(NBA_CHECK_LINE_REUSE)
+    std::fill(std::begin(reused), std::end(reused), false);
+#endif
+  }
+
+  /// Applies a write to the shadow memory, returns false if it left the memory unchanged.
+  bool Write(Memory memory, std::uint32_t address, std::uint8_t const* data, std::uint32_t size) {
+    static constexpr std::uint32_t s_shadow_base[3] = { 0x00000, 0x00400, 0x00800 };
+
+    auto index = static_cast<int>(memory);
+    auto target = &shadow[s_shadow_base[index] + address];
+
+    if (std::memcmp(target, data, size) == 0) {
+      return false;
+    }
+
+    std::memcpy(target, data, size);
+    version[index]++;
+    return true;
+  }
+
+  /// Returns true if the line described by a register snapshot may be skipped,
+  /// otherwise takes note of it being rendered now.
+  bool Reuse(PPU::MMIO const& mmio) {
+    auto& line = lines[mmio.vcount];
+
+    /* OAM is only read if OBJs are enabled (DISPCNT bit 12). */
+    bool oam_used = mmio.dispcnt.enable[4];
+
+    bool unchanged = line.valid &&
+      line.version[int(Memory::PRAM)] == version[int(Memory::PRAM)] &&
+      line.version[int(Memory::VRAM)] == version[int(Memory::VRAM)] &&
+      (line.version[int(Memory::OAM)] == version[int(Memory::OAM)] || !oam_used) &&
+      std::memcmp(&line.mmio, &mmio, sizeof(PPU::MMIO)) == 0;
+
+    if (!unchanged) {
+      frame_changed = true;
+    }
+
+#if defined(NBA_CHECK_LINE_REUSE)
+    reused[mmio.vcount] = unchanged;
+    unchanged = false;
+#endif
+
+    if (!unchanged) {
+      line.valid = true;
+      std::memcpy(line.version, version, sizeof(version));
+      std::memcpy(&line.mmio, &mmio, sizeof(PPU::MMIO));
+    }
+
+    return unchanged;
+  }
+
+  /// Called with the output once a rendered frame is complete, but not for skipped frames.
+  /// Returns false if every row of the output was kept from an earlier frame.
+  bool EndFrame(void const* output) {
+    bool changed = frame_changed;
+
+    frame_changed = false;
+
+#if defined(NBA_CHECK_LINE_REUSE)
+    for (int y = 0; y < 160; y++) {
+      if (reused[y] && std::memcmp((std::uint8_t const*)output + y * row_size, &previous[y * row_size], row_size) != 0) {
+        LOG_ERROR("Line {0} was considered unchanged, but rendered differently.", y);
+      }
+    }
+
+    std::memcpy(previous, output, 160 * row_size);
+    std::fill(std::begin(reused), std::end(reused), false);
+#endif
+
+    return changed;
+  }
+
+private:
+  struct Line {
+    bool valid;
+    std::uint64_t version[3];
+    PPU::MMIO mmio;
+  } lines[160];
+
+  /* PRAM, OAM and VRAM, in the order of RenderThread::Memory. */
+  std::unique_ptr<std::uint8_t[]> shadow;
+  std::uint64_t version[3] = { 0, 0, 0 };
+
+  /* Set once a line is rendered, until the end of the frame. */
+  bool frame_changed;
+
+#if defined(NBA_CHECK_LINE_REUSE)
+  int row_size;
+  bool reused[160];
+  std::uint8_t previous[240 * 160 * 4] = {};
+#endif
+};
+
+} // namespace nba::core
@@ -0,0 +1,21 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include "null_renderer.hpp"
+
+namespace nba::core {
+
+NullRenderer::NullRenderer(Scheduler* scheduler,
+                           InterruptController* irq_controller,
+                           DMA* dma,
+                           common::MemoryArena& arena)
+  : nba::core::PPU(scheduler, irq_controller, dma, arena)
+{
+  Reset();
+}
+
+} // namespace nba::core
@@ -0,0 +1,28 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <emulator/core/hw/dma.hpp>
+#include <emulator/core/scheduler.hpp>
+#include <emulator/core/hw/ppu/ppu.hpp>
+
+namespace nba::core {
+
+/* PPU without any output, for headless runs.
+ * The status flags, interrupts, DMA requests and affine reference points behave exactly
+ * the same as with the other renderers, but nothing is ever rendered or drawn.
+ */
+class NullRenderer final : public nba::core::PPU {
+public:
+  NullRenderer(Scheduler* scheduler,
+               InterruptController* irq_controller,
+               DMA* dma,
+               common::MemoryArena& arena);
+};
+
+} // namespace nba::core
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace nba::core {
+
+/* Sets of the OBJs whose view rectangle overlaps each visible scanline.
+ * An OBJ is re-binned whenever its attributes are written to, so the OBJ renderer
+ * only has to visit the OBJs of the current line rather than all 128.
+ */
+struct ObjectBins {
+  ObjectBins(std::uint8_t const* oam) : oam(oam) {
+    std::fill(&objects[0][0], &objects[0][0] + 160 * 2, 0);
+    std::fill(std::begin(first_line), std::end(first_line), 0);
+    std::fill(std::begin(last_line), std::end(last_line), 0);
+    Invalidate();
+  }
+
+  void Invalidate() { Update(0, 0x400); }
+
+  /// Re-bins the OBJs overlapping a range of OAM.
+  void Update(std::uint32_t address, std::uint32_t size) {
+    auto last = (address + size - 1) / 8;
+
+    for (auto object = address / 8; object <= last; object++) {
+      Bin(object);
+    }
+  }
+
+  /// Returns the number of the lowest set bit of a non-zero OBJ mask.
+  static auto LowestObject(std::uint64_t mask) -> int {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return int(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+  }
+
+  /// Bit n of the two words is set if OBJ (64 * word + n) overlaps the line.
+  std::uint64_t objects[160][2];
+
+private:
+  void Bin(int object) {
+    auto attr0 = (oam[object * 8 + 1] << 8) | oam[object * 8 + 0];
+    auto attr1 = (oam[object * 8 + 3] << 8) | oam[object * 8 + 2];
+
+    int first = 0;
+    int last = 0;
+
+    /* Neither disabled (affine=0, attr0bit9=1) nor prohibited OBJs are ever displayed. */
+    if (((attr0 >> 8) & 3) != 2 && ((attr0 >> 10) & 3) != 3) {
+      int y = attr0 & 0xFF;
+      int height = s_obj_height[attr0 >> 14][attr1 >> 14];
+
+      if (y >= 160) y -= 256;
+
+      /* Double-size affine OBJs have a view rectangle of twice the height. */
+      if ((attr0 >> 8) & 2) {
+        height *= 2;
+      }
+
+      first = std::clamp(y, 0, 160);
+      last = std::clamp(y + height, 0, 160);
+    }
+
+    if (first == first_line[object] && last == last_line[object]) {
+      return;
+    }
+
+    auto word = object / 64;
+    auto bit = std::uint64_t{1} << (object % 64);
+
+    for (int line = first_line[object]; line < last_line[object]; line++) {
+      objects[line][word] &= ~bit;
+    }
+
+    for (int line = first; line < last; line++) {
+      objects[line][word] |= bit;
+    }
+
+    first_line[object] = first;
+    last_line[object] = last;
+  }
+
+  static constexpr std::uint8_t s_obj_height[4][4] = {
+    {  8, 16, 32, 64 }, /* SQUARE */
+    {  8,  8, 16, 32 }, /* HORIZONTAL */
+    { 16, 32, 32, 64 }, /* VERTICAL */
+    {  0,  0,  0,  0 }  /* PROHIBITED */
+  };
+
+  std::uint8_t const* oam;
+
+  std::uint8_t first_line[128];
+  std::uint8_t last_line[128];
+};
+
+} // namespace nba::core
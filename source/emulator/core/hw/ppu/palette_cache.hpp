@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace nba::core {
+
+/* Host-endian copy of the 512 palette entries as 15-bit colors.
+ * Entries are updated whenever palette RAM is written to.
+ */
+struct PaletteCache {
+  PaletteCache(std::uint8_t const* pram) : pram(pram) {
+    Invalidate();
+  }
+
+  void Invalidate() { Update(0, 0x400); }
+
+  /// Updates the palette entries overlapping a range of palette RAM.
+  void Update(std::uint32_t address, std::uint32_t size) {
+    auto last = (address + size - 1) / 2;
+
+    for (auto entry = address / 2; entry <= last; entry++) {
+      color15[entry] = ((pram[entry * 2 + 1] << 8) | pram[entry * 2]) & 0x7FFF;
+    }
+  }
+
+  std::uint16_t color15[512];
+
+private:
+  std::uint8_t const* pram;
+};
+
+} // namespace nba::core
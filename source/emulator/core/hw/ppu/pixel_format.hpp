@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <emulator/device/video_device.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#endif
+
+namespace nba::core {
+
+/* Converts a line of 240 15-bit colors to the output pixel format.
+ * 8-bit channels are the 5-bit channels shifted up, 6-bit green is 5-bit green shifted up.
+ * SSE2 is part of every x86-64 CPU, so it is used without a runtime check.
+ */
+inline void ConvertLine(PixelFormat format, std::uint16_t const* colors, void* line) {
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+  auto const mask_r = _mm_set1_epi16(0x001F);
+  auto const mask_g = _mm_set1_epi16(0x03E0);
+  auto const mask_b = _mm_set1_epi16(0x7C00);
+
+  for (int x = 0; x < 240; x += 8) {
+    auto color = _mm_loadu_si128((__m128i const*)&colors[x]);
+    auto r = _mm_and_si128(color, mask_r);
+    auto g = _mm_and_si128(color, mask_g);
+    auto b = _mm_and_si128(color, mask_b);
+
+    if (format == PixelFormat::BGR555) {
+      _mm_storeu_si128((__m128i*)((std::uint16_t*)line + x), _mm_or_si128(_mm_or_si128(r, g), b));
+    } else if (format == PixelFormat::RGB565) {
+      auto result = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 1)), _mm_srli_epi16(b, 10));
+
+      _mm_storeu_si128((__m128i*)((std::uint16_t*)line + x), result);
+    } else {
+      /* The low halves of the 32-bit pixels hold green and one of red or blue, the high halves alpha and the other one. */
+      auto const alpha = _mm_set1_epi16(std::int16_t(0xFF00));
+
+      auto g8 = _mm_slli_epi16(g, 6);
+      auto r8 = _mm_slli_epi16(r, 3);
+      auto b8 = _mm_srli_epi16(b, 7);
+
+      __m128i low;
+      __m128i high;
+
+      if (format == PixelFormat::ARGB8888) {
+        low = _mm_or_si128(g8, b8);
+        high = _mm_or_si128(alpha, r8);
+      } else {
+        low = _mm_or_si128(g8, r8);
+        high = _mm_or_si128(alpha, b8);
+      }
+
+      auto pixels = (__m128i*)((std::uint32_t*)line + x);
+
+      _mm_storeu_si128(pixels + 0, _mm_unpacklo_epi16(low, high));
+      _mm_storeu_si128(pixels + 1, _mm_unpackhi_epi16(low, high));
+    }
+  }
+#else
+  for (int x = 0; x < 240; x++) {
+    int r = (colors[x] >>  0) & 0x1F;
+    int g = (colors[x] >>  5) & 0x1F;
+    int b = (colors[x] >> 10) & 0x1F;
+
+    switch (format) {
+      case PixelFormat::BGR555:
+        ((std::uint16_t*)line)[x] = colors[x] & 0x7FFF;
+        break;
+      case PixelFormat::RGB565:
+        ((std::uint16_t*)line)[x] = r << 11 | g << 6 | b;
+        break;
+      case PixelFormat::ARGB8888:
+        ((std::uint32_t*)line)[x] = 0xFF000000 | r << 19 | g << 11 | b << 3;
+        break;
+      case PixelFormat::ABGR8888:
+        ((std::uint32_t*)line)[x] = 0xFF000000 | b << 19 | g << 11 | r << 3;
+        break;
+    }
+  }
+#endif
+}
+
+} // namespace nba::core
@@ -1,24 +1,45 @@
 #pragma once
 
+#include <common/memory_arena.hpp>
+#include <emulator/core/hw/dma.hpp>
 #include <emulator/core/hw/interrupt.hpp>
 #include <emulator/core/hw/ppu/registers.hpp>
+#include <emulator/core/scheduler.hpp>
+#include <functional>
 
 namespace nba::core {
 
+/* Steps through the phases of each scanline and frame, and updates the status flags,
+ * raises interrupts, requests DMAs and advances the affine reference points accordingly.
+ * Renderers only implement the hooks that submit the scanlines and frames.
+ */
 class PPU {
 public:
-    PPU(InterruptController* irq_controller) : irq_controller{irq_controller} {};
+    PPU(Scheduler* scheduler, InterruptController* irq_controller, DMA* dma, common::MemoryArena& arena)
+        : pram{arena.Allocate(0x00400)}
+        , oam{arena.Allocate(0x00400)}
+        , vram{arena.Allocate(0x18000)}
+        , irq_controller{irq_controller}
+        , scheduler{scheduler}
+        , dma{dma} {
+        mmio.dispstat.ppu = this;
+    };
     virtual ~PPU() = default;
 
     virtual void Reset();
-    virtual void HookPRAM(std::uint32_t address, std::uint32_t size){};
-    virtual void HookVRAM(std::uint32_t address, std::uint32_t size){};
-    virtual void HookOAM(std::uint32_t address, std::uint32_t size){};
-    virtual void HookMMIO(std::uint32_t address){};
 
-    std::uint8_t pram[0x00400];
-    std::uint8_t oam[0x00400];
-    std::uint8_t vram[0x18000];
+    /* Notify the renderer of writes to video memory and PPU registers.
+     * These are deliberately non-virtual: the CPU invokes them on the concrete
+     * renderer type (see RendererRef), so a renderer implements a hook by hiding it.
+     */
+    void HookPRAM(std::uint32_t address, std::uint32_t size) {}
+    void HookVRAM(std::uint32_t address, std::uint32_t size) {}
+    void HookOAM(std::uint32_t address, std::uint32_t size) {}
+    void HookMMIO(std::uint32_t address) {}
+
+    std::uint8_t* pram;
+    std::uint8_t* oam;
+    std::uint8_t* vram;
 
     struct MMIO {
         DisplayControl dispcnt;
@@ -53,8 +74,43 @@ public:
     void CheckVerticalCounterIRQ();
 
 protected:
+    /// Called at the end of the visible part of each scanline, before HBlank starts.
+    virtual void SubmitScanline() {}
+
+    /// Called once the last visible scanline is complete, before VBlank starts.
+    virtual void SubmitFrame() {}
 
     InterruptController* irq_controller{};
+
+private:
+    enum class Phase {
+        SCANLINE = 0,
+        HBLANK_SEARCH = 1,
+        HBLANK = 2,
+        VBLANK_SCANLINE = 3,
+        VBLANK_HBLANK = 4
+    };
+
+    void Tick(int cycles_late);
+
+    void UpdateInternalAffineRegisters();
+
+    void SetNextEvent(Phase phase, int cycles_late);
+    void OnScanlineComplete(int cycles_late);
+    void OnHblankSearchComplete(int cycles_late);
+    void OnHblankComplete(int cycles_late);
+    void OnVblankScanlineComplete(int cycles_late);
+    void OnVblankHblankComplete(int cycles_late);
+
+    Scheduler* scheduler;
+    DMA* dma;
+    std::function<void(int)> event_cb = [this](int cycles_late) {
+        this->Tick(cycles_late);
+    };
+
+    Phase phase;
+
+    static constexpr int s_wait_cycles[5] = { 960, 46, 226, 1006, 226 };
 };
 
 } // namespace nba::core
@@ -61,42 +61,32 @@ void DisplayControl::Write(int address, std::uint8_t value) {
 }
 
 void DisplayStatus::Reset() {
-  Write(0, 0);
-  Write(1, 0);
+  Write(0, 0xFFFF);
 }
 
-auto DisplayStatus::Read(int address) -> std::uint8_t {
-  switch (address) {
-  case 0:
-    return vblank_flag |
-          (hblank_flag << 1) |
-          (vcount_flag << 2) |
-          (vblank_irq_enable << 3) |
-          (hblank_irq_enable << 4) |
-          (vcount_irq_enable << 5);
-  case 1:
-    return vcount_setting;
-  }
-
-  return 0;
+auto DisplayStatus::Read() -> std::uint16_t {
+  return vblank_flag |
+        (hblank_flag << 1) |
+        (vcount_flag << 2) |
+        (vblank_irq_enable << 3) |
+        (hblank_irq_enable << 4) |
+        (vcount_irq_enable << 5) |
+        (vcount_setting << 8);
 }
 
-void DisplayStatus::Write(int address, std::uint8_t value) {
-  switch (address) {
-  case 0:
+void DisplayStatus::Write(std::uint16_t value, std::uint16_t mask) {
+  if (mask & 0x00FF) {
     vblank_irq_enable = (value >> 3) & 1;
     hblank_irq_enable = (value >> 4) & 1;
     vcount_irq_enable = (value >> 5) & 1;
-    if (ppu != nullptr) {
-      ppu->CheckVerticalCounterIRQ();
-    }
-    break;
-  case 1:
-    vcount_setting = value;
-    if (ppu != nullptr) {
-      ppu->CheckVerticalCounterIRQ();
-    }
-    break;
+  }
+
+  if (mask & 0xFF00) {
+    vcount_setting = value >> 8;
+  }
+
+  if (ppu != nullptr) {
+    ppu->CheckVerticalCounterIRQ();
   }
 }
 
@@ -163,17 +153,14 @@ void ReferencePoint::Write(int address, std::uint8_t value) {
 void WindowRange::Reset() {
   min = 0;
   max = 0;
-  _changed = false;
 }
 
 void WindowRange::Write(int address, std::uint8_t value) {
   switch (address) {
   case 0:
-    if (value != max) _changed = true;
     max = value;
     break;
   case 1:
-    if (value != min) _changed = true;
     min = value;
     break;
   }
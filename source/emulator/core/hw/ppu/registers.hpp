@@ -39,8 +39,8 @@ struct DisplayStatus {
   int vcount_setting;
 
   void Reset();
-  auto Read(int address) -> std::uint8_t;
-  void Write(int address, std::uint8_t value);
+  auto Read() -> std::uint16_t;
+  void Write(std::uint16_t value, std::uint16_t mask);
 };
 
 struct BackgroundControl {
@@ -89,7 +89,6 @@ struct BlendControl {
 struct WindowRange {
   int min;
   int max;
-  bool _changed;
 
   void Reset();
   void Write(int address, std::uint8_t value);
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include "../line_renderer.hpp"
+
+namespace nba::core {
+
+void LineRenderer::RenderLayerAffine(int id) {
+  auto const& bg = render_mmio.bgcnt[2 + id];
+  
+  int size = 128 << bg.size;
+  std::uint32_t map_base  = bg.map_block * 2048;
+  std::uint32_t tile_base = bg.tile_block * 16384;
+
+  AffineRenderLoop(id, size, size, [&](std::uint16_t* buffer,
+                                       int count,
+                                       std::int32_t ref_x,
+                                       std::int32_t ref_y,
+                                       std::int32_t dx,
+                                       std::int32_t dy,
+                                       bool) {
+    /* The kernel always wraps around, which does not matter for samples inside the map. */
+    AffineKernel::SampleTileMap(render_vram, map_base, tile_base, size, buffer, count, ref_x, ref_y, dx, dy);
+  });
+}
+
+} // namespace nba::core
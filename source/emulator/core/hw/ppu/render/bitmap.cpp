@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include "../line_renderer.hpp"
+
+namespace nba::core {
+
+void LineRenderer::RenderLayerBitmap1() {
+  AffineRenderBitmap<240, 160>([&](int x, int y) -> std::uint16_t {
+    int index = y * 480 + x * 2;
+    
+    return (render_vram[index + 1] << 8) | render_vram[index];
+  }, [&](std::uint16_t* buffer, int x, int y, int count) {
+    ReadBitmapLine16(buffer, &render_vram[y * 480 + x * 2], count);
+  });
+}
+
+void LineRenderer::RenderLayerBitmap2() {  
+  auto frame = render_mmio.dispcnt.frame * 0xA000;
+  
+  AffineRenderBitmap<240, 160>([&](int x, int y) -> std::uint16_t {
+    return render_vram[frame + y * 240 + x];
+  }, [&](std::uint16_t* buffer, int x, int y, int count) {
+    ReadBitmapLine8(buffer, &render_vram[frame + y * 240 + x], count);
+  });
+}
+
+void LineRenderer::RenderLayerBitmap3() {
+  auto frame = render_mmio.dispcnt.frame * 0xA000;
+  
+  AffineRenderBitmap<160, 128>([&](int x, int y) -> std::uint16_t {
+    int index = frame + y * 320 + x * 2;
+    
+    return (render_vram[index + 1] << 8) | render_vram[index];
+  }, [&](std::uint16_t* buffer, int x, int y, int count) {
+    ReadBitmapLine16(buffer, &render_vram[frame + y * 320 + x * 2], count);
+  });
+}
+
+} // namespace nba::core
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <algorithm>
+
+#include "../line_renderer.hpp"
+
+namespace nba::core {
+
+const int LineRenderer::s_obj_size[4][4][2] = {
+  /* SQUARE */
+  {
+    { 8 , 8  },
+    { 16, 16 },
+    { 32, 32 },
+    { 64, 64 }
+  },
+  /* HORIZONTAL */
+  {
+    { 16, 8  },
+    { 32, 8  },
+    { 32, 16 },
+    { 64, 32 }
+  },
+  /* VERTICAL */
+  {
+    { 8 , 16 },
+    { 8 , 32 },
+    { 16, 32 },
+    { 32, 64 }
+  },
+  /* PROHIBITED */
+  {
+    { 0, 0 },
+    { 0, 0 },
+    { 0, 0 },
+    { 0, 0 }
+  }
+};
+
+void LineRenderer::RenderLayerOAM(bool bitmap_mode) {  
+  /* 2d-affine transform matrix (pa, pb, pc, pd). */
+  std::int16_t transform[4];
+
+  int tile_num;
+  std::uint16_t pixel;
+  
+  line_contains_alpha_obj = false;
+  
+  int cycles = 0;
+  int cycle_limit = render_mmio.dispcnt.hblank_oam_access ? 954 : 1210;
+
+  std::fill_n(buffer_obj.color, 240, s_color_transparent);
+  std::fill_n(buffer_obj.priority, 240, 4);
+  std::fill_n(buffer_obj.alpha, 240, 0);
+  std::fill_n(buffer_obj.window, 240, 0);
+
+  /* Visit the OBJs overlapping the line in OAM order. Disabled OBJs are never binned. */
+  auto const& bin = object_bins.objects[render_mmio.vcount];
+  std::uint64_t objects[2] = { bin[0], bin[1] };
+
+  while (objects[0] != 0 || objects[1] != 0) {
+    int word = objects[0] != 0 ? 0 : 1;
+    std::int32_t offset = (word * 64 + ObjectBins::LowestObject(objects[word])) * 8;
+
+    objects[word] &= objects[word] - 1;
+
+    std::uint16_t attr0 = (render_oam[offset + 1] << 8) | render_oam[offset + 0];
+    std::uint16_t attr1 = (render_oam[offset + 3] << 8) | render_oam[offset + 2];
+    std::uint16_t attr2 = (render_oam[offset + 5] << 8) | render_oam[offset + 4];
+
+    int width;
+    int height;
+
+    std::int32_t x = attr1 & 0x1FF;
+    std::int32_t y = attr0 & 0x0FF;
+    int shape  =  attr0 >> 14;
+    int size   =  attr1 >> 14;
+    int prio   = (attr2 >> 10) & 3;
+    int mode   = (attr0 >> 10) & 3;
+    int mosaic = (attr0 >> 12) & 1;
+
+    if (mode == OBJ_PROHIBITED) {
+      continue;
+    }
+
+    if (x >= 240) x -= 512;
+    if (y >= 160) y -= 256;
+
+    int affine  = (attr0 >> 8) & 1;
+    int attr0b9 = (attr0 >> 9) & 1;
+
+    /* Decode OBJ width and height. */
+    width  = s_obj_size[shape][size][0];
+    height = s_obj_size[shape][size][1];
+
+    int rect_width  = width;
+    int rect_height = height;
+
+    int half_width  = width / 2;
+    int half_height = height / 2;
+
+    /* Set x and y to OBJ origin. */
+    x += half_width;
+    y += half_height;
+
+    int cycles_per_pixel = 1;
+
+    /* Load transform matrix. */
+    if (affine) {
+      int group = ((attr1 >> 9) & 0x1F) << 5;
+
+      /* Read transform matrix. */
+      transform[0] = (render_oam[group + 0x7 ] << 8) | render_oam[group + 0x6 ];
+      transform[1] = (render_oam[group + 0xF ] << 8) | render_oam[group + 0xE ];
+      transform[2] = (render_oam[group + 0x17] << 8) | render_oam[group + 0x16];
+      transform[3] = (render_oam[group + 0x1F] << 8) | render_oam[group + 0x1E];
+
+      /* Check double-size flag. Doubles size of the view rectangle. */
+      if (attr0b9) {
+        x += half_width;
+        y += half_height;
+        rect_width  *= 2;
+        rect_height *= 2;
+        half_width  *= 2;
+        half_height *= 2;
+      }
+
+      cycles_per_pixel = 2;
+    } else {
+      /* Set transform to identity:
+       * [ 1 0 ]
+       * [ 0 1 ]
+       */
+      transform[0] = 0x100;
+      transform[1] = 0;
+      transform[2] = 0;
+      transform[3] = 0x100;
+    }
+    
+    int line = render_mmio.vcount;
+
+    /* Bail out if scanline is outside OBJ's view rectangle. */
+    if (line < (y - half_height) || line >= (y + half_height)) {
+      continue;
+    }
+
+    int local_y = line - y;
+    int number  =  attr2 & 0x3FF;
+    int palette = (attr2 >> 12) + 16;
+    int flip_h  = !affine && (attr1 & (1 << 12));
+    int flip_v  = !affine && (attr1 & (1 << 13));
+    int is_256  = (attr0 >> 13) & 1;
+
+    std::uint32_t tile_base = 0x10000;
+
+    if (is_256) {
+      if ((number & 1) && render_mmio.dispcnt.oam_mapping_1d) {
+        tile_base = 0x10020;
+      }
+      number /= 2;
+    }
+
+    /* Number of tiles from one row of tiles to the next. */
+    int tile_stride;
+
+    if (render_mmio.dispcnt.oam_mapping_1d) {
+      tile_stride = width / 8;
+    } else {
+      tile_stride = is_256 ? 16 : 32; /* check me */
+    }
+
+    /* Tiles below this number overlap the bitmap and are not displayed. */
+    int tile_min = bitmap_mode ? (is_256 ? 256 : 512) : 0;
+
+    int mosaic_x = 0;
+    
+    if (mosaic) {
+      mosaic_x = (x - half_width) % render_mmio.mosaic.obj.size_x;
+      local_y -= render_mmio.mosaic.obj._counter_y;
+    }
+    
+    if (affine) {
+      cycles += 10;
+    }
+
+    /* The OBJ is rendered from local_x = -half_width up to and including half_width,
+     * taking cycles_per_pixel for each. It is cut off where the cycles of the line run out.
+     */
+    int count = rect_width + 1;
+    int budget = cycles > cycle_limit ? 0 : (cycle_limit - cycles) / cycles_per_pixel + 1;
+    bool cut_off = budget < count;
+
+    if (cut_off) {
+      count = budget;
+    }
+
+    cycles += count * cycles_per_pixel;
+
+    /* The pixels of [0, count) that are on screen, relative to the left edge of the view rectangle. */
+    int left = x - half_width;
+    int first = std::max(0, -left);
+    int last = std::min(count, 240 - left);
+
+    /* Returns zero for pixels of tiles that are not displayed, which no palette entry ever is. */
+    auto fetch = [&](int tex_x, int tex_y) -> std::uint16_t {
+      int tile_x  = tex_x % 8;
+      int tile_y  = tex_y % 8;
+      int block_x = tex_x / 8;
+      int block_y = tex_y / 8;
+
+      tile_num = number + block_y * tile_stride + block_x;
+
+      if (tile_num < tile_min) {
+        return 0;
+      }
+
+      if (is_256) {
+        return DecodeTilePixel8BPP(tile_base, tile_num, tile_x, tile_y, true);
+      } else {
+        /* 4BPP tile numbers wrap around within the 32 KiB of OBJ VRAM. */
+        return DecodeTilePixel4BPP(tile_base, palette, tile_num & 0x3FF, tile_x, tile_y);
+      }
+    };
+
+    auto plot = [&](int global_x, std::uint16_t pixel) {
+      auto& priority = buffer_obj.priority[global_x];
+      
+      if (pixel != s_color_transparent) {
+        if (mode == OBJ_WINDOW) {
+          buffer_obj.window[global_x] = 1;
+        } else if (prio < priority || buffer_obj.color[global_x] == s_color_transparent) {
+          priority = prio;
+          buffer_obj.color[global_x] = pixel;
+          buffer_obj.alpha[global_x] = (mode == OBJ_SEMI) ? 1 : 0;
+          if (mode == OBJ_SEMI) {
+            line_contains_alpha_obj = true;
+          }
+        }
+      }
+
+      if (prio < priority) {
+        priority = prio;
+      }
+    };
+
+    if (mosaic) {
+      /* Render OBJ scanline. */
+      for (int i = 0; i < count; i++) {
+        int local_x = i - half_width;
+        int _local_x = local_x - mosaic_x;
+        int global_x = local_x + x;
+
+        if (++mosaic_x == render_mmio.mosaic.obj.size_x) {
+          mosaic_x = 0;
+        }
+      
+        if (global_x < 0 || global_x >= 240) {
+          continue;
+        }
+
+        int tex_x = ((transform[0] * _local_x + transform[1] * local_y) >> 8) + (width / 2);
+        int tex_y = ((transform[2] * _local_x + transform[3] * local_y) >> 8) + (height / 2);
+
+        /* Check if transformed coordinates are inside bounds. */
+        if (tex_x >= width || tex_y >= height ||
+          tex_x < 0 || tex_y < 0) {
+          continue;
+        }
+
+        if (flip_h) tex_x = width  - tex_x - 1;
+        if (flip_v) tex_y = height - tex_y - 1;
+
+        if ((pixel = fetch(tex_x, tex_y)) != 0) {
+          plot(global_x, pixel);
+        }
+      }
+    } else if (affine) {
+      /* Step the texture coordinate (in 20.8 fixed point, relative to the top-left of the texture)
+       * along the line, and only visit the pixels that fall within the texture.
+       */
+      std::int32_t tex_x = transform[0] * (first - half_width) + transform[1] * local_y + (width  / 2 << 8);
+      std::int32_t tex_y = transform[2] * (first - half_width) + transform[3] * local_y + (height / 2 << 8);
+
+      auto span = AffineKernel::VisibleSpan(
+        tex_x, tex_y, transform[0], transform[2], std::max(last - first, 0), width, height);
+
+      tex_x += span.first * transform[0];
+      tex_y += span.first * transform[2];
+
+      for (int i = first + span.first; i < first + span.last; i++) {
+        if ((pixel = fetch(tex_x >> 8, tex_y >> 8)) != 0) {
+          plot(left + i, pixel);
+        }
+        tex_x += transform[0];
+        tex_y += transform[2];
+      }
+    } else {
+      /* The last pixel of the view rectangle lies outside of the texture. */
+      last = std::min(last, width);
+
+      int tex_y = local_y + height / 2;
+
+      if (flip_v) tex_y = height - tex_y - 1;
+
+      int tile_y  = tex_y % 8;
+      int block_y = tex_y / 8;
+
+      /* Decode the OBJ line tile by tile, skipping lines of tiles without any opaque pixel. */
+      for (int block = first / 8; block * 8 < last; block++) {
+        int block_first = std::max(block * 8, first);
+        int block_last  = std::min(block * 8 + 8, last);
+
+        tile_num = number + block_y * tile_stride + (flip_h ? (width / 8 - 1 - block) : block);
+
+        if (tile_num < tile_min) {
+          continue;
+        }
+
+        bool opaque;
+        std::uint16_t tile_line[8];
+
+        if (is_256) {
+          opaque = tile_cache.IsOpaque8(tile_base + tile_num * 64 + tile_y * 8);
+          if (opaque) {
+            DecodeTileLine8BPP(tile_line, tile_base, tile_num, tile_y, flip_h, true);
+          }
+        } else {
+          opaque = tile_cache.IsOpaque4(tile_base + (tile_num & 0x3FF) * 32, tile_y);
+          if (opaque) {
+            DecodeTileLine4BPP(tile_line, tile_base, palette, tile_num & 0x3FF, tile_y, flip_h);
+          }
+        }
+
+        if (opaque) {
+          for (int i = block_first; i < block_last; i++) {
+            plot(left + i, tile_line[i - block * 8]);
+          }
+        } else {
+          for (int i = block_first; i < block_last; i++) {
+            auto& priority = buffer_obj.priority[left + i];
+
+            priority = std::min<std::uint8_t>(priority, prio);
+          }
+        }
+      }
+    }
+
+    if (cut_off) {
+      return;
+    }
+  }
+}
+
+} // namespace nba::core
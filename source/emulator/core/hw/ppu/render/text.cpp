@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include "../line_renderer.hpp"
+
+namespace nba::core {
+
+void LineRenderer::RenderLayerText(int id) {
+  auto const& bgcnt  = render_mmio.bgcnt[id];
+  auto const& mosaic = render_mmio.mosaic.bg;
+  
+  std::uint16_t* buffer = &buffer_bg[id][s_line_padding];
+  std::uint32_t tile_base = bgcnt.tile_block * 16384;
+   
+  int line = render_mmio.bgvofs[id] + render_mmio.vcount;
+  
+  /* Apply vertical mosaic */
+  if (bgcnt.mosaic_enable) {
+    line -= mosaic._counter_y;
+  }
+
+  int grid_y = line / 8;
+  int tile_y = line % 8;
+  int screen_y = (grid_y / 32) % 2;
+
+  /* Map row in the left screen block. Wide maps continue in the screen block to its right. */
+  std::uint32_t map_base = (bgcnt.map_block * 2048) + ((grid_y % 32) * 64);
+
+  switch (bgcnt.size) {
+    case 2: map_base += screen_y * 2048; break;
+    case 3: map_base += screen_y * 4096; break;
+  }
+
+  int scroll_x = render_mmio.bghofs[id];
+  bool wide = bgcnt.size & 1;
+
+  if (bgcnt.full_palette) {
+    if (wide) {
+      RenderLayerTextLine<true, true>(buffer, map_base, tile_base, scroll_x, tile_y);
+    } else {
+      RenderLayerTextLine<true, false>(buffer, map_base, tile_base, scroll_x, tile_y);
+    }
+  } else {
+    if (wide) {
+      RenderLayerTextLine<false, true>(buffer, map_base, tile_base, scroll_x, tile_y);
+    } else {
+      RenderLayerTextLine<false, false>(buffer, map_base, tile_base, scroll_x, tile_y);
+    }
+  }
+
+  /* Apply horizontal mosaic. */
+  if (bgcnt.mosaic_enable && mosaic.size_x != 1) {
+    for (int x = 0; x < 240; x += mosaic.size_x) {
+      std::fill(&buffer[x + 1], &buffer[std::min(x + mosaic.size_x, 240)], buffer[x]);
+    }
+  }
+}
+
+template<bool full_palette, bool wide>
+void LineRenderer::RenderLayerTextLine(std::uint16_t* buffer,
+                                            std::uint32_t map_base,
+                                            std::uint32_t tile_base,
+                                            int scroll_x,
+                                            int tile_y) {
+  constexpr int columns = wide ? 64 : 32;
+
+  int grid_x = scroll_x / 8;
+
+  /* Draw 31 whole tiles, starting at the scroll offset up to seven pixels left of the line. */
+  buffer -= scroll_x % 8;
+
+  for (int i = 0; i < 31; i++) {
+    int column = (grid_x + i) % columns;
+    std::uint32_t offset = map_base + (column / 32) * 2048 + (column % 32) * 2;
+
+    std::uint16_t encoder = (render_vram[offset + 1] << 8) | render_vram[offset];
+
+    int number  = encoder & 0x3FF;
+    bool flip_x = encoder & (1 << 10);
+    bool flip_y = encoder & (1 << 11);
+    int _tile_y = flip_y ? (tile_y ^ 7) : tile_y;
+
+    if constexpr (full_palette) {
+      DecodeTileLine8BPP(buffer, tile_base, number, _tile_y, flip_x);
+    } else {
+      DecodeTileLine4BPP(buffer, tile_base, encoder >> 12, number, _tile_y, flip_x);
+    }
+
+    buffer += 8;
+  }
+}
+
+} // namespace nba::core
@@ -5,13 +5,13 @@
  * Refer to the included LICENSE file.
  */
 
-#include "vulkan_renderer.hpp"
+#include "../line_renderer.hpp"
 
 namespace nba::core {
 
-void VulkanRenderer::RenderWindow(int id) {
-  int line = mmio.vcount;
-  auto& winv = mmio.winv[id];
+void LineRenderer::RenderWindow(int id) {
+  int line = render_mmio.vcount;
+  auto& winv = render_mmio.winv[id];
 
   /* Check if the current scanline is outside of the window. */
   if ((winv.min <= winv.max && (line < winv.min || line >= winv.max)) ||
@@ -19,24 +19,8 @@ void VulkanRenderer::RenderWindow(int id) {
     /* Mark window as inactive during the current scanline. */
     window_scanline_enable[id] = false;
   } else {
-    auto& winh = mmio.winh[id];
-
     /* Mark window as active during the current scanline. */
     window_scanline_enable[id] = true;
-
-    /* Only recalculate the LUTs if min/max changed between the last update & now. */
-    if (winh._changed) {
-      if (winh.min <= winh.max) {
-        for (int x = 0; x < 240; x++) {
-          buffer_win[id][x] = x >= winh.min && x < winh.max;
-        }
-      } else {
-        for (int x = 0; x < 240; x++) {
-          buffer_win[id][x] = x >= winh.min || x < winh.max;
-        }
-      }
-      winh._changed = false;
-    }
   }
 }
 
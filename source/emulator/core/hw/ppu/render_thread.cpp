@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#include "render_thread.hpp"
+
+namespace nba::core {
+
+static_assert(std::is_trivially_copyable_v<PPU::MMIO>, "PPU registers must be trivially copyable");
+static_assert(sizeof(PPU::MMIO) <= 0x1000, "PPU registers must fit into a single ring entry");
+
+RenderThread::RenderThread(WriteCallback on_write, LineCallback on_line)
+  : on_write(std::move(on_write))
+  , on_line(std::move(on_line))
+  , buffer(new std::uint8_t[kCapacity])
+{
+  thread = std::thread{[this]() { Run(); }};
+}
+
+RenderThread::~RenderThread() {
+  {
+    std::lock_guard guard{mutex};
+    running = false;
+  }
+  wake.notify_one();
+  thread.join();
+}
+
+void RenderThread::SubmitWrite(Memory memory, std::uint32_t address, std::uint8_t const* data, std::uint32_t size) {
+  auto command = static_cast<Command>(memory);
+
+  // Large writes (from DMA bursts) are split so that every entry fits the payload buffer.
+  while (size > 0) {
+    auto chunk = std::min(size, kMaxPayload);
+
+    Push(command, address, data, chunk);
+    address += chunk;
+    data += chunk;
+    size -= chunk;
+  }
+}
+
+void RenderThread::SubmitLine(PPU::MMIO const& mmio) {
+  Push(Command::Line, 0, &mmio, sizeof(mmio));
+}
+
+void RenderThread::Wait() {
+  std::unique_lock lock{mutex};
+
+  idle.wait(lock, [this]() {
+    return sleeping && tail == head;
+  });
+}
+
+void RenderThread::Push(Command command, std::uint32_t address, void const* data, std::uint32_t size) {
+  Header header{command, address, size};
+  auto position = head.load(std::memory_order_relaxed);
+  auto length = sizeof(header) + size;
+
+  /* The ring only fills up if the render thread falls behind by a lot.
+   * It is running in that case, so there is nobody to wake up.
+   */
+  while (position + length - tail.load(std::memory_order_acquire) > kCapacity) {
+    std::this_thread::yield();
+  }
+
+  CopyIn(position, &header, sizeof(header));
+  CopyIn(position + sizeof(header), data, size);
+  head = position + length;
+
+  if (sleeping) {
+    std::lock_guard guard{mutex};
+    wake.notify_one();
+  }
+}
+
+void RenderThread::CopyIn(std::size_t position, void const* data, std::size_t size) {
+  auto offset = position % kCapacity;
+  auto first = std::min(size, kCapacity - offset);
+
+  std::memcpy(&buffer[offset], data, first);
+  std::memcpy(&buffer[0], static_cast<std::uint8_t const*>(data) + first, size - first);
+}
+
+void RenderThread::CopyOut(std::size_t position, void* data, std::size_t size) {
+  auto offset = position % kCapacity;
+  auto first = std::min(size, kCapacity - offset);
+
+  std::memcpy(data, &buffer[offset], first);
+  std::memcpy(static_cast<std::uint8_t*>(data) + first, &buffer[0], size - first);
+}
+
+void RenderThread::Run() {
+  Header header;
+  PPU::MMIO mmio;
+  std::uint8_t payload[kMaxPayload];
+  auto position = tail.load(std::memory_order_relaxed);
+
+  while (running) {
+    if (position == head) {
+      std::unique_lock lock{mutex};
+
+      sleeping = true;
+      idle.notify_all();
+      wake.wait(lock, [&]() {
+        return position != head || !running;
+      });
+      sleeping = false;
+      continue;
+    }
+
+    CopyOut(position, &header, sizeof(header));
+
+    if (header.command == Command::Line) {
+      CopyOut(position + sizeof(header), &mmio, sizeof(mmio));
+      on_line(mmio);
+    } else {
+      CopyOut(position + sizeof(header), payload, header.size);
+      on_write(static_cast<Memory>(header.command), header.address, payload, header.size);
+    }
+
+    position += sizeof(header) + header.size;
+    tail.store(position, std::memory_order_release);
+  }
+}
+
+} // namespace nba::core
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <emulator/core/hw/ppu/ppu.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace nba::core {
+
+/* Runs the scanline renderer on a dedicated thread.
+ * The emulation thread submits every write to video memory and, at the end of each HDraw,
+ * a snapshot of the PPU registers. Both travel in order through a lock-free
+ * single-producer single-consumer ring, so the render thread sees video memory and
+ * registers exactly as they were when the line would have been rendered synchronously.
+ */
+class RenderThread {
+public:
+  enum class Memory : std::uint32_t {
+    PRAM,
+    OAM,
+    VRAM
+  };
+
+  /// Invoked on the render thread for each write, with a copy of the written bytes.
+  using WriteCallback = std::function<void(Memory memory, std::uint32_t address, std::uint8_t const* data, std::uint32_t size)>;
+
+  /// Invoked on the render thread for each scanline, with its register snapshot.
+  using LineCallback = std::function<void(PPU::MMIO const& mmio)>;
+
+  RenderThread(WriteCallback on_write, LineCallback on_line);
+ ~RenderThread();
+
+  void SubmitWrite(Memory memory, std::uint32_t address, std::uint8_t const* data, std::uint32_t size);
+  void SubmitLine(PPU::MMIO const& mmio);
+
+  /// Blocks until all submitted work has been processed.
+  void Wait();
+
+private:
+  static constexpr std::size_t kCapacity = 0x100000;
+  static constexpr std::uint32_t kMaxPayload = 0x1000;
+
+  enum class Command : std::uint32_t {
+    WritePRAM,
+    WriteOAM,
+    WriteVRAM,
+    Line
+  };
+
+  struct Header {
+    Command command;
+    std::uint32_t address;
+    std::uint32_t size;
+  };
+
+  void Push(Command command, std::uint32_t address, void const* data, std::uint32_t size);
+  void CopyIn(std::size_t position, void const* data, std::size_t size);
+  void CopyOut(std::size_t position, void* data, std::size_t size);
+  void Run();
+
+  WriteCallback on_write;
+  LineCallback on_line;
+
+  std::unique_ptr<std::uint8_t[]> buffer;
+
+  /// Total number of bytes ever written to and read from the ring.
+  alignas(64) std::atomic<std::size_t> head{0};
+  alignas(64) std::atomic<std::size_t> tail{0};
+
+  /* The render thread only sleeps once it has drained the ring. */
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable idle;
+  std::atomic<bool> sleeping{false};
+  std::atomic<bool> running{true};
+
+  std::thread thread;
+};
+
+} // namespace nba::core
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#include <common/log.hpp>
+
+#include "renderer.hpp"
+
+namespace nba::core {
+
+auto CreateRenderer(Scheduler* scheduler,
+                    InterruptController* irq_controller,
+                    DMA* dma,
+                    std::shared_ptr<Config> config,
+                    common::MemoryArena& arena,
+                    RendererRef& renderer_ref) -> std::unique_ptr<PPU> {
+  using Renderer = Config::Video::Renderer;
+
+  auto renderer = config->video.renderer;
+
+  if (renderer == Renderer::Vulkan && !config->vulkan_frontend) {
+    LOG_WARN("No Vulkan frontend available, falling back to the software renderer.");
+    renderer = Renderer::Software;
+  }
+
+  switch (renderer) {
+    case Renderer::Vulkan: {
+      auto vulkan_renderer = std::make_unique<VulkanRenderer>(scheduler, irq_controller, dma, config, arena);
+      renderer_ref = vulkan_renderer.get();
+      return vulkan_renderer;
+    }
+    case Renderer::Null: {
+      auto null_renderer = std::make_unique<NullRenderer>(scheduler, irq_controller, dma, arena);
+      renderer_ref = null_renderer.get();
+      return null_renderer;
+    }
+    default: {
+      auto software_renderer = std::make_unique<SoftwareRenderer>(scheduler, irq_controller, dma, config, arena);
+      renderer_ref = software_renderer.get();
+      return software_renderer;
+    }
+  }
+}
+
+} // namespace nba::core
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <emulator/core/hw/ppu/frame_renderer.hpp>
+#include <emulator/core/hw/ppu/null_render/null_renderer.hpp>
+#include <emulator/core/hw/ppu/software_render/software_renderer.hpp>
+#include <emulator/core/hw/ppu/vulkan_render/vulkan_renderer.hpp>
+#include <memory>
+#include <variant>
+
+namespace nba::core {
+
+/* Non-owning reference to the concrete renderer behind CPU::ppu.
+ * The memory hooks are dispatched through this with std::visit, which lets
+ * empty hooks compile away and non-empty hooks be inlined into the memory handlers.
+ * The software and Vulkan renderers share their hooks, so both are referred to as a FrameRenderer.
+ */
+using RendererRef = std::variant<FrameRenderer*, NullRenderer*>;
+
+/// Creates the renderer selected by config->video.renderer and points renderer_ref at it.
+/// The Vulkan renderer falls back to the software renderer if no Vulkan frontend is configured.
+auto CreateRenderer(Scheduler* scheduler,
+                    InterruptController* irq_controller,
+                    DMA* dma,
+                    std::shared_ptr<Config> config,
+                    common::MemoryArena& arena,
+                    RendererRef& renderer_ref) -> std::unique_ptr<PPU>;
+
+} // namespace nba::core
@@ -5,184 +5,24 @@
  * Refer to the included LICENSE file.
  */
 
-#include <cstring>
-
 #include "software_renderer.hpp"
 
 namespace nba::core {
 
-constexpr std::uint16_t SoftwareRenderer::s_color_transparent;
-constexpr int SoftwareRenderer::s_wait_cycles[5];
-
 SoftwareRenderer::SoftwareRenderer(Scheduler* scheduler,
          InterruptController* irq_controller,
          DMA* dma,
-         std::shared_ptr<Config> config)
-  : nba::core::PPU(irq_controller)
-  , scheduler(scheduler)
-  , dma(dma)
-  , config(config)
-{
-  InitBlendTable();
-  Reset();
-  mmio.dispstat.ppu = this;
-}
-
-void SoftwareRenderer::Reset() {
-  PPU::Reset();
-  SetNextEvent(Phase::SCANLINE, 0);
-}
-
-void SoftwareRenderer::SetNextEvent(Phase phase, int cycles_late) {
-  this->phase = phase;
-  scheduler->Add(s_wait_cycles[static_cast<int>(phase)] - cycles_late, event_cb);
-}
-
-void SoftwareRenderer::Tick(int cycles_late) {
-  // TODO: get rid of the indirection and schedule the appropriate method directly.
-  switch (phase) {
-    case Phase::SCANLINE:
-      OnScanlineComplete(cycles_late);
-      break;
-    case Phase::HBLANK_SEARCH:
-      OnHblankSearchComplete(cycles_late);
-      break;
-    case Phase::HBLANK:
-      OnHblankComplete(cycles_late);
-      break;
-    case Phase::VBLANK_SCANLINE:
-      OnVblankScanlineComplete(cycles_late);
-      break;
-    case Phase::VBLANK_HBLANK:
-      OnVblankHblankComplete(cycles_late);
-      break;
-  }
-}
-
-void SoftwareRenderer::UpdateInternalAffineRegisters() {
-  auto& bgx = mmio.bgx;
-  auto& bgy = mmio.bgy;
-  auto& mosaic = mmio.mosaic;
-
-  if (mmio.vcount == 160 || mmio.dispcnt._mode_is_dirty) {
-    mmio.dispcnt._mode_is_dirty = false;
-
-    /* Reload internal affine registers */
-    bgx[0]._current = bgx[0].initial;
-    bgy[0]._current = bgy[0].initial;
-    bgx[1]._current = bgx[1].initial;
-    bgy[1]._current = bgy[1].initial;
-  } else {
-    for (int i = 0; i < 2; i++) {
-      if (mmio.bgcnt[2 + i].mosaic_enable) {
-        /* Vertical mosaic for affine-transformed layers. */
-        if (mosaic.bg._counter_y == 0) {
-          bgx[i]._current += mosaic.bg.size_y * mmio.bgpb[i];
-          bgy[i]._current += mosaic.bg.size_y * mmio.bgpd[i];
-        }
-      } else {
-        bgx[i]._current += mmio.bgpb[i];
-        bgy[i]._current += mmio.bgpd[i];
-      }
-    }
-  }
-}
-
-void SoftwareRenderer::OnScanlineComplete(int cycles_late) {
-  SetNextEvent(Phase::HBLANK_SEARCH, cycles_late);
-
-  if (mmio.dispstat.hblank_irq_enable) {
-    irq_controller->Raise(InterruptSource::HBlank);
-  }
-
-  RenderScanline();
-}
-
-void SoftwareRenderer::OnHblankSearchComplete(int cycles_late) {
-  SetNextEvent(Phase::HBLANK, cycles_late);
-
-  dma->Request(DMA::Occasion::HBlank);
-  if (mmio.vcount >= 2) {
-    dma->Request(DMA::Occasion::Video);
-  }
-  mmio.dispstat.hblank_flag = 1;
-}
-
-void SoftwareRenderer::OnHblankComplete(int cycles_late) {
-  auto& vcount = mmio.vcount;
-  auto& dispstat = mmio.dispstat;
-  auto& mosaic = mmio.mosaic;
-
-  dispstat.hblank_flag = 0;
-  vcount++;
-  CheckVerticalCounterIRQ();
-
-  if (vcount == 160) {
-    config->video_dev->Draw(output);
-
-    SetNextEvent(Phase::VBLANK_SCANLINE, cycles_late);
-    dma->Request(DMA::Occasion::VBlank);
-    dispstat.vblank_flag = 1;
-
-    if (dispstat.vblank_irq_enable) {
-      irq_controller->Raise(InterruptSource::VBlank);
-    }
-
-    /* Reset vertical mosaic counters */
-    mosaic.bg._counter_y = 0;
-    mosaic.obj._counter_y = 0;
-  } else {
-    /* Advance vertical background mosaic counter */
-    if (++mosaic.bg._counter_y == mosaic.bg.size_y) {
-      mosaic.bg._counter_y = 0;
-    }
-
-    /* Advance vertical OBJ mosaic counter */
-    if (++mosaic.obj._counter_y == mosaic.obj.size_y) {
-      mosaic.obj._counter_y = 0;
-    }
-
-    SetNextEvent(Phase::SCANLINE, cycles_late);
-  }
-
-  UpdateInternalAffineRegisters();
-}
-
-void SoftwareRenderer::OnVblankScanlineComplete(int cycles_late) {
-  auto& dispstat = mmio.dispstat;
-
-  SetNextEvent(Phase::VBLANK_HBLANK, cycles_late);
-  dispstat.hblank_flag = 1;
-
-  if (mmio.vcount < 162) {
-    dma->Request(DMA::Occasion::Video);
-  } else if (mmio.vcount == 162) {
-    dma->StopVideoXferDMA();
-  }
-
-  if (dispstat.hblank_irq_enable) {
-    irq_controller->Raise(InterruptSource::HBlank);
-  }
-}
-
-void SoftwareRenderer::OnVblankHblankComplete(int cycles_late) {
-  auto& vcount = mmio.vcount;
-  auto& dispstat = mmio.dispstat;
-
-  dispstat.hblank_flag = 0;
-
-  if (vcount == 227) {
-    vcount = 0;
-    SetNextEvent(Phase::SCANLINE, cycles_late);
+         std::shared_ptr<Config> config,
+         common::MemoryArena& arena)
+  : nba::core::FrameRenderer(scheduler, irq_controller, dma, config, arena, config->video.pixel_format)
+{ }
+
+void SoftwareRenderer::Draw(std::uint32_t* frame, bool changed) {
+  if (changed) {
+    config->video_dev->Draw(frame);
   } else {
-    SetNextEvent(Phase::VBLANK_SCANLINE, cycles_late);
-    if (vcount == 226) {
-      dispstat.vblank_flag = 0;
-    }
-    vcount++;
+    config->video_dev->DrawUnchanged(frame);
   }
-
-  CheckVerticalCounterIRQ();
 }
 
 } // namespace nba::core
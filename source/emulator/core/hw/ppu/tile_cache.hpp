@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+namespace nba::core {
+
+/* Cache of 4BPP tiles, decoded to one palette index per byte (8x8 row-major).
+ * 8BPP tiles already are stored that way in VRAM and need no cache.
+ * Tiles are decoded on their first use after being written to.
+ *
+ * Alongside, it records which rows of each 32 bytes of VRAM are non-zero,
+ * so that fully transparent rows of tiles can be skipped.
+ */
+struct TileCache {
+  static constexpr int kTileCount = 0x18000 / 32;
+
+  TileCache(std::uint8_t const* vram) : vram(vram) { Invalidate(); }
+
+  void Invalidate() {
+    std::fill(std::begin(dirty), std::end(dirty), true);
+  }
+
+  /// Marks the tiles overlapping a range of VRAM as dirty.
+  void Invalidate(std::uint32_t address, std::uint32_t size) {
+    auto last = (address + size - 1) / 32;
+
+    for (auto tile = address / 32; tile <= last; tile++) {
+      dirty[tile] = true;
+    }
+  }
+
+  /// Returns the decoded 4BPP tile at a 32-byte aligned VRAM address.
+  auto GetTile4BPP(std::uint32_t address) -> std::uint8_t const* {
+    auto tile = address / 32;
+
+    if (dirty[tile]) {
+      Decode(tile);
+    }
+
+    return decoded[tile];
+  }
+
+  /// Returns whether the eight bytes of VRAM at an 8-byte aligned address are not all zero,
+  /// i.e. if that line of an 8BPP tile has any opaque pixel.
+  auto IsOpaque8(std::uint32_t address) -> bool {
+    /* 8BPP OBJ tiles may be fetched past the end of VRAM. */
+    if (address >= 0x18000) {
+      return true;
+    }
+
+    auto tile = address / 32;
+
+    if (dirty[tile]) {
+      Decode(tile);
+    }
+
+    return (opaque_rows[tile] >> ((address % 32) / 4)) & 3;
+  }
+
+  /// Returns whether a line of the 4BPP tile at a 32-byte aligned VRAM address has any opaque pixel.
+  auto IsOpaque4(std::uint32_t address, int y) -> bool {
+    auto tile = address / 32;
+
+    if (dirty[tile]) {
+      Decode(tile);
+    }
+
+    return (opaque_rows[tile] >> y) & 1;
+  }
+
+private:
+  void Decode(std::uint32_t tile) {
+    auto data = &vram[tile * 32];
+    auto indices = decoded[tile];
+    std::uint8_t rows = 0;
+
+    for (int i = 0; i < 32; i++) {
+      indices[i * 2 + 0] = data[i] & 15;
+      indices[i * 2 + 1] = data[i] >> 4;
+
+      if (data[i] != 0) {
+        rows |= 1 << (i / 4);
+      }
+    }
+
+    opaque_rows[tile] = rows;
+    dirty[tile] = false;
+  }
+
+  std::uint8_t const* vram;
+
+  bool dirty[kTileCount];
+  std::uint8_t decoded[kTileCount][64];
+
+  /// Bit n is set if bytes 4n - 4n+3 of the 32 bytes are not all zero.
+  std::uint8_t opaque_rows[kTileCount];
+};
+
+} // namespace nba::core
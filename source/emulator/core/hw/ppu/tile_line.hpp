@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2020 fleroviux
+ *
+ * Licensed under GPLv3 or any later version.
+ * Refer to the included LICENSE file.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <emulator/core/hw/ppu/compositor.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#endif
+
+namespace nba::core {
+
+/* Expands one line of a tile (eight palette indices) into palette entries with a single store.
+ * Index zero becomes transparent, any other index is offset by palette_base.
+ * SSE2 is part of every x86-64 CPU, so it is used without a runtime check.
+ */
+inline void ExpandTileLine(std::uint16_t* buffer, std::uint8_t const* indices, int palette_base, bool flip) {
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+  auto const zero = _mm_setzero_si128();
+  auto index = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i const*)indices), zero);
+
+  if (flip) {
+    index = _mm_shuffle_epi32(index, 0x4E);
+    index = _mm_shufflelo_epi16(index, 0x1B);
+    index = _mm_shufflehi_epi16(index, 0x1B);
+  }
+
+  auto is_transparent = _mm_cmpeq_epi16(index, zero);
+  auto entry = _mm_add_epi16(index, _mm_set1_epi16(std::int16_t(palette_base)));
+  auto transparent = _mm_set1_epi16(std::int16_t(Compositor::s_color_transparent));
+
+  _mm_storeu_si128((__m128i*)buffer, _mm_or_si128(_mm_andnot_si128(is_transparent, entry),
+                                                  _mm_and_si128(is_transparent, transparent)));
+#else
+  for (int x = 0; x < 8; x++) {
+    int index = indices[flip ? (x ^ 7) : x];
+    buffer[x] = index ? (palette_base + index) : Compositor::s_color_transparent;
+  }
+#endif
+}
+
+} // namespace nba::core
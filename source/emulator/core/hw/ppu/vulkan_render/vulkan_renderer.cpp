@@ -5,24 +5,28 @@
  * Refer to the included LICENSE file.
  */
 
-#include <cstring>
+#include <algorithm>
 
 #include "frontend.hpp"
 #include "vulkan_renderer.hpp"
 
 namespace nba::core {
 
-constexpr std::uint16_t VulkanRenderer::s_color_transparent;
-constexpr int VulkanRenderer::s_wait_cycles[5];
+/* The staging image only supports 32-bit formats. */
+static auto StagingFormat(PixelFormat format) -> PixelFormat {
+    if (BytesPerPixel(format) != 4) {
+        LOG_WARN("Vulkan renderer only supports 32-bit pixel formats, falling back to ARGB8888.");
+        return PixelFormat::ARGB8888;
+    }
+    return format;
+}
 
 VulkanRenderer::VulkanRenderer(Scheduler* scheduler, InterruptController* irq_controller, DMA* dma,
-                               std::shared_ptr<Config> config)
-    : nba::core::PPU(irq_controller), scheduler(scheduler), dma(dma),
-      config(config), frontend{config->vulkan_frontend} {
+                               std::shared_ptr<Config> config, common::MemoryArena& arena)
+    : nba::core::FrameRenderer(scheduler, irq_controller, dma, config, arena,
+                               StagingFormat(config->video.pixel_format)),
+      frontend{config->vulkan_frontend} {
     ASSERT(frontend, "Vulkan Frontend not initialized!");
-    InitBlendTable();
-    Reset();
-    mmio.dispstat.ppu = this;
 
     vk.physical_device = frontend->GetVulkanInstance().enumeratePhysicalDevices()[0];
     {
@@ -83,7 +87,9 @@ VulkanRenderer::VulkanRenderer(Scheduler* scheduler, InterruptController* irq_co
         staging_image_create_info.extent = vk::Extent3D{native_width, native_height, 1};
         staging_image_create_info.arrayLayers = 1;
         staging_image_create_info.mipLevels = 1;
-        staging_image_create_info.format = vk::Format::eB8G8R8A8Unorm;
+        staging_image_create_info.format = pixel_format == PixelFormat::ABGR8888
+                                                  ? vk::Format::eR8G8B8A8Unorm
+                                                  : vk::Format::eB8G8R8A8Unorm;
         staging_image_create_info.tiling = vk::ImageTiling::eLinear;
         staging_image_create_info.initialLayout = vk::ImageLayout::eUndefined;
         staging_image_create_info.sharingMode = vk::SharingMode::eExclusive;
@@ -212,17 +218,15 @@ VulkanRenderer::~VulkanRenderer() {
     vk.device->unmapMemory(*staging.memory);
 }
 
-void VulkanRenderer::Reset() {
-    PPU::Reset();
-    SetNextEvent(Phase::SCANLINE, 0);
-}
-
-void VulkanRenderer::Draw() {
+void VulkanRenderer::Draw(std::uint32_t* frame, bool changed) {
     auto [image_index, acquire_image_semaphore] = swapchain.AcquireImage();
     vk.device->waitForFences(*staging.fence, true, std::numeric_limits<std::uint64_t>::max());
     vk.device->resetFences(*staging.fence);
 
-    std::copy(output.begin(), output.end(), staging.ptr);
+    /* The staging image still holds the previous frame. */
+    if (changed) {
+        std::copy_n(frame, native_width * native_height, staging.ptr);
+    }
     {
         vk::SubmitInfo submit_info;
         submit_info.commandBufferCount = 1;
@@ -239,156 +243,4 @@ void VulkanRenderer::Draw() {
     ++frontend->frame_count;
 }
 
-void VulkanRenderer::SetNextEvent(Phase phase, int cycles_late) {
-    this->phase = phase;
-    scheduler->Add(s_wait_cycles[static_cast<int>(phase)] - cycles_late, event_cb);
-}
-
-void VulkanRenderer::Tick(int cycles_late) {
-    // TODO: get rid of the indirection and schedule the appropriate method directly.
-    switch (phase) {
-    case Phase::SCANLINE:
-        OnScanlineComplete(cycles_late);
-        break;
-    case Phase::HBLANK_SEARCH:
-        OnHblankSearchComplete(cycles_late);
-        break;
-    case Phase::HBLANK:
-        OnHblankComplete(cycles_late);
-        break;
-    case Phase::VBLANK_SCANLINE:
-        OnVblankScanlineComplete(cycles_late);
-        break;
-    case Phase::VBLANK_HBLANK:
-        OnVblankHblankComplete(cycles_late);
-        break;
-    }
-}
-
-void VulkanRenderer::UpdateInternalAffineRegisters() {
-    auto& bgx = mmio.bgx;
-    auto& bgy = mmio.bgy;
-    auto& mosaic = mmio.mosaic;
-
-    if (mmio.vcount == 160 || mmio.dispcnt._mode_is_dirty) {
-        mmio.dispcnt._mode_is_dirty = false;
-
-        /* Reload internal affine registers */
-        bgx[0]._current = bgx[0].initial;
-        bgy[0]._current = bgy[0].initial;
-        bgx[1]._current = bgx[1].initial;
-        bgy[1]._current = bgy[1].initial;
-    } else {
-        for (int i = 0; i < 2; i++) {
-            if (mmio.bgcnt[2 + i].mosaic_enable) {
-                /* Vertical mosaic for affine-transformed layers. */
-                if (mosaic.bg._counter_y == 0) {
-                    bgx[i]._current += mosaic.bg.size_y * mmio.bgpb[i];
-                    bgy[i]._current += mosaic.bg.size_y * mmio.bgpd[i];
-                }
-            } else {
-                bgx[i]._current += mmio.bgpb[i];
-                bgy[i]._current += mmio.bgpd[i];
-            }
-        }
-    }
-}
-
-void VulkanRenderer::OnScanlineComplete(int cycles_late) {
-    SetNextEvent(Phase::HBLANK_SEARCH, cycles_late);
-
-    if (mmio.dispstat.hblank_irq_enable) {
-        irq_controller->Raise(InterruptSource::HBlank);
-    }
-
-    RenderScanline();
-}
-
-void VulkanRenderer::OnHblankSearchComplete(int cycles_late) {
-    SetNextEvent(Phase::HBLANK, cycles_late);
-
-    dma->Request(DMA::Occasion::HBlank);
-    if (mmio.vcount >= 2) {
-        dma->Request(DMA::Occasion::Video);
-    }
-    mmio.dispstat.hblank_flag = 1;
-}
-
-void VulkanRenderer::OnHblankComplete(int cycles_late) {
-    auto& vcount = mmio.vcount;
-    auto& dispstat = mmio.dispstat;
-    auto& mosaic = mmio.mosaic;
-
-    dispstat.hblank_flag = 0;
-    vcount++;
-    CheckVerticalCounterIRQ();
-
-    if (vcount == 160) {
-        Draw();
-
-        SetNextEvent(Phase::VBLANK_SCANLINE, cycles_late);
-        dma->Request(DMA::Occasion::VBlank);
-        dispstat.vblank_flag = 1;
-
-        if (dispstat.vblank_irq_enable) {
-            irq_controller->Raise(InterruptSource::VBlank);
-        }
-
-        /* Reset vertical mosaic counters */
-        mosaic.bg._counter_y = 0;
-        mosaic.obj._counter_y = 0;
-    } else {
-        /* Advance vertical background mosaic counter */
-        if (++mosaic.bg._counter_y == mosaic.bg.size_y) {
-            mosaic.bg._counter_y = 0;
-        }
-
-        /* Advance vertical OBJ mosaic counter */
-        if (++mosaic.obj._counter_y == mosaic.obj.size_y) {
-            mosaic.obj._counter_y = 0;
-        }
-
-        SetNextEvent(Phase::SCANLINE, cycles_late);
-    }
-
-    UpdateInternalAffineRegisters();
-}
-
-void VulkanRenderer::OnVblankScanlineComplete(int cycles_late) {
-    auto& dispstat = mmio.dispstat;
-
-    SetNextEvent(Phase::VBLANK_HBLANK, cycles_late);
-    dispstat.hblank_flag = 1;
-
-    if (mmio.vcount < 162) {
-        dma->Request(DMA::Occasion::Video);
-    } else if (mmio.vcount == 162) {
-        dma->StopVideoXferDMA();
-    }
-
-    if (dispstat.hblank_irq_enable) {
-        irq_controller->Raise(InterruptSource::HBlank);
-    }
-}
-
-void VulkanRenderer::OnVblankHblankComplete(int cycles_late) {
-    auto& vcount = mmio.vcount;
-    auto& dispstat = mmio.dispstat;
-
-    dispstat.hblank_flag = 0;
-
-    if (vcount == 227) {
-        vcount = 0;
-        SetNextEvent(Phase::SCANLINE, cycles_late);
-    } else {
-        SetNextEvent(Phase::VBLANK_SCANLINE, cycles_late);
-        if (vcount == 226) {
-            dispstat.vblank_flag = 0;
-        }
-        vcount++;
-    }
-
-    CheckVerticalCounterIRQ();
-}
-
 } // namespace nba::core
@@ -28,7 +28,7 @@ void Timer::Reset() {
   }
 }
 
-auto Timer::Read(int chan_id, int offset) -> std::uint8_t {
+auto Timer::Read(int chan_id, int offset) -> std::uint16_t {
   auto const& channel = channels[chan_id];
   auto const& control = channel.control;
 
@@ -48,11 +48,8 @@ auto Timer::Read(int chan_id, int offset) -> std::uint8_t {
   }
 
   switch (offset) {
-    case REG_TMXCNT_L | 0: {
-      return counter & 0xFF;
-    }
-    case REG_TMXCNT_L | 1: {
-      return counter >> 8;
+    case REG_TMXCNT_L: {
+      return counter & 0xFFFF;
     }
     case REG_TMXCNT_H: {
       return (control.frequency) |
@@ -64,14 +61,18 @@ auto Timer::Read(int chan_id, int offset) -> std::uint8_t {
   }
 }
 
-void Timer::Write(int chan_id, int offset, std::uint8_t value) {
+void Timer::Write(int chan_id, int offset, std::uint16_t value, std::uint16_t mask) {
   auto& channel = channels[chan_id];
   auto& control = channel.control;
 
   switch (offset) {
-    case REG_TMXCNT_L | 0: channel.reload = (channel.reload & 0xFF00) | (value << 0); break;
-    case REG_TMXCNT_L | 1: channel.reload = (channel.reload & 0x00FF) | (value << 8); break;
+    case REG_TMXCNT_L: channel.reload = (channel.reload & ~mask) | (value & mask); break;
     case REG_TMXCNT_H: {
+      // The upper byte of TMxCNT_H is unused.
+      if (~mask & 0x00FF) {
+        break;
+      }
+
       bool enable_previous = control.enable;
 
       if (channel.running) {
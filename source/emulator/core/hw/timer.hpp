@@ -20,8 +20,8 @@ public:
   Timer(Scheduler* scheduler, InterruptController* irq_controller, APU* apu) : scheduler(scheduler), irq_controller(irq_controller) , apu(apu) { Reset(); }
 
   void Reset();
-  auto Read (int chan_id, int offset) -> std::uint8_t;
-  void Write(int chan_id, int offset, std::uint8_t value);
+  auto Read (int chan_id, int offset) -> std::uint16_t;
+  void Write(int chan_id, int offset, std::uint16_t value, std::uint16_t mask);
 
 private:
   enum Registers {
@@ -7,19 +7,52 @@
 
 #pragma once
 
+#include <array>
+#include <common/triple_buffer.hpp>
 #include <cstdint>
+#include <memory>
 
 namespace nba {
 
+/* Layout of the pixels in a frame, from the least significant bit up.
+ * Frames are packed, so rows are 240 times the size of a pixel apart.
+ */
+enum class PixelFormat {
+  BGR555,   /* The native GBA color format: 5 bits each of red, green and blue. */
+  RGB565,   /* 5 bits of blue, 6 bits of green and 5 bits of red. */
+  ARGB8888, /* 8 bits each of blue, green, red and alpha, i.e. 0xAARRGGBB. */
+  ABGR8888  /* 8 bits each of red, green, blue and alpha, i.e. 0xAABBGGRR. */
+};
+
+constexpr auto BytesPerPixel(PixelFormat format) -> int {
+  return (format == PixelFormat::BGR555 || format == PixelFormat::RGB565) ? 2 : 4;
+}
+
 class VideoDevice {
 public:
+  /// Large enough for a frame in any pixel format.
+  using Frame = std::array<std::uint32_t, 240 * 160>;
+  using FrameBuffer = common::TripleBuffer<Frame>;
+
   virtual ~VideoDevice() {}
 
+  /// Called by the renderer with the triple buffer that it publishes each frame to before drawing it.
+  /// Another thread may acquire the latest frame from it at any time, without copying.
+  /// The buffer has a single consumer, so a device must not hand it on to more than one other device.
+  virtual void SetFrameBuffer(std::shared_ptr<FrameBuffer>) { }
+
+  /// Called once a frame is complete, in the format selected by Config::Video::pixel_format.
+  /// The buffer is valid for the duration of the call.
   virtual void Draw(std::uint32_t* buffer) = 0;
+
+  /// Called instead of Draw() if the frame is identical to the previously drawn frame,
+  /// so that uploading or encoding it again can be skipped. By default it is drawn anyway.
+  virtual void DrawUnchanged(std::uint32_t* buffer) { Draw(buffer); }
 };
 
 class NullVideoDevice : public VideoDevice {
   void Draw(std::uint32_t* buffer) { }
+  void DrawUnchanged(std::uint32_t*) { }
 };
 
 } // namespace nba
@@ -15,6 +15,7 @@
 #include <emulator/cartridge/backup/flash.hpp>
 #include <emulator/cartridge/backup/sram.hpp>
 #include <emulator/cartridge/gpio/rtc.hpp>
+#include <emulator/cartridge/rom_cache.hpp>
 #include <common/log.hpp>
 #include <cstring>
 #include <exception>
@@ -155,21 +156,19 @@ auto Emulator::LoadGame(std::string const& path) -> StatusCode {
     return StatusCode::GameWrongSize;
   }
 
-  std::ifstream stream { path, std::ios::binary };
+  /* The ROM image is shared with other emulator instances that loaded the same game. */
+  auto rom = ROMCache::Load(path);
 
   /* TODO: most likely this error would only happen
    * if the file cannot be opened due to missing privileges.
    * The status code "Game not found" is not accurate, really.
    */
-  if (!stream.good()) {
+  if (!rom.data || rom.size != size) {
     LOG_ERROR("Failed to open ROM with unknown error.");
     return StatusCode::GameNotFound;
   }
 
-  auto rom = std::make_unique<std::uint8_t[]>(size);
-  Header* header = reinterpret_cast<Header*>(rom.get());
-  stream.read((char*)(rom.get()), size);
-  stream.close();
+  Header* header = reinterpret_cast<Header*>(rom.data.get());
 
   game_title.assign(header->game.title, 12);
   game_code.assign(header->game.code, 4);
@@ -192,7 +191,7 @@ auto Emulator::LoadGame(std::string const& path) -> StatusCode {
      */
     if (game_info.backup_type == Config::BackupType::Detect) {
       LOG_INFO("Unable to get backup type from game database.");
-      game_info.backup_type = DetectBackupType(rom.get(), size);
+      game_info.backup_type = DetectBackupType(rom.data.get(), size);
       if (game_info.backup_type == Config::BackupType::Detect) {
         game_info.backup_type = Config::BackupType::SRAM;
         LOG_WARN("Failed to determine backup type, fallback to SRAM.");
@@ -210,7 +209,7 @@ auto Emulator::LoadGame(std::string const& path) -> StatusCode {
   LOG_INFO("Mirror: {0}", game_info.mirror);
 
   /* Mount cartridge into the cartridge slot. */
-  cpu.memory.rom.data = std::move(rom);
+  cpu.memory.rom.data = std::move(rom.data);
   cpu.memory.rom.size = size;
   if (game_info.backup_type == Config::BackupType::EEPROM_4 || game_info.backup_type == Config::BackupType::EEPROM_64) {
     cpu.memory.rom.backup_sram.reset();
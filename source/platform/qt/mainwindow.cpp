@@ -31,10 +31,29 @@ MainWindow::MainWindow(QApplication* app, QWidget* parent) : QMainWindow(parent)
   CreateHelpMenu(menubar);
 
   /* Set emulator config */
+  screen->SetPixelFormat(config->video.pixel_format);
+  screen->SetColorCorrection(!config->video.color_correction);
+
+  if (config->video.scaler != nba::Config::Video::Scaler::None && nba::BytesPerPixel(config->video.pixel_format) == 4) {
+    auto filter = config->video.scaler == nba::Config::Video::Scaler::Nearest
+      ? common::Scaler::Filter::Nearest
+      : common::Scaler::Filter::ScaleNx;
+
+    screen->SetScaler(std::make_unique<common::Scaler>(filter, config->video.scale, config->video.scaler_threads));
+  }
   config->video_dev = screen;
   config->audio_dev = std::make_shared<SDL2_AudioDevice>();
   config->input_dev = input_device;
+
+  /* The Qt frontend has no Vulkan surface, so the shared default "vulkan" renders in software.
+   * The choice is restored afterwards to keep it intact in the written configuration.
+   */
+  auto renderer = config->video.renderer;
+  if (renderer == nba::Config::Video::Renderer::Vulkan) {
+    config->video.renderer = nba::Config::Video::Renderer::Software;
+  }
   emulator = std::make_unique<nba::Emulator>(config);
+  config->video.renderer = renderer;
 
   app->installEventFilter(this);
 }
@@ -10,10 +10,41 @@
 #include "screen.hpp"
 
 void Screen::Draw(std::uint32_t* buffer) {
-  emit SignalDraw(buffer);
+  emit SignalDraw();
 }
 
-void Screen::DrawSlot(std::uint32_t* buffer) {
+void Screen::DrawSlot() {
+  auto& frame = frame_buffer->Acquire();
+  void const* pixels = frame.data();
+  int width = 240;
+  int height = 160;
+
+  if (scaler) {
+    scaler->Scale(frame.data(), width, height, scaled.data());
+    pixels = scaled.data();
+    width *= scaler->Factor();
+    height *= scaler->Factor();
+  }
+
+  GLenum format = GL_BGRA;
+  GLenum type = GL_UNSIGNED_BYTE;
+
+  switch (pixel_format) {
+    case nba::PixelFormat::BGR555:
+      format = GL_RGBA;
+      type = GL_UNSIGNED_SHORT_1_5_5_5_REV;
+      break;
+    case nba::PixelFormat::RGB565:
+      format = GL_RGB;
+      type = GL_UNSIGNED_SHORT_5_6_5;
+      break;
+    case nba::PixelFormat::ARGB8888:
+      break;
+    case nba::PixelFormat::ABGR8888:
+      format = GL_RGBA;
+      break;
+  }
+
   glBindTexture(GL_TEXTURE_2D, texture);
 
   /* Update texture pixels */
@@ -21,12 +52,12 @@ void Screen::DrawSlot(std::uint32_t* buffer) {
           GL_TEXTURE_2D,
           0,
           GL_RGBA,
-          240, /* TODO: do not hardcode the dimensions? */
-          160,
+          width,
+          height,
           0,
-          GL_BGRA,
-          GL_UNSIGNED_BYTE,
-          buffer
+          format,
+          type,
+          pixels
   );
 
   /* Redraw screen */
@@ -101,7 +132,7 @@ void Screen::paintGL() {
 
   glViewport(viewport_x, 0, viewport_width, viewport_height);
   glBindTexture(GL_TEXTURE_2D, texture);
-  ctx.glUseProgram(program);
+  ctx.glUseProgram(color_correction ? program : 0);
 
   glBegin(GL_QUADS);
   {
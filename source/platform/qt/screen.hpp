@@ -9,7 +9,10 @@
 
 #include <QGLWidget>
 #include <QOpenGLWidget>
+#include <common/scaler.hpp>
 #include <emulator/device/video_device.hpp>
+#include <memory>
+#include <vector>
 
 class Screen : public QOpenGLWidget,
                public nba::VideoDevice {
@@ -28,8 +31,33 @@ public:
 
   ~Screen() override { glDeleteTextures(1, &texture); }
 
+  void SetFrameBuffer(std::shared_ptr<FrameBuffer> frame_buffer) final {
+    this->frame_buffer = frame_buffer;
+  }
+
+  /* Must match the pixel format the renderer was created with. */
+  void SetPixelFormat(nba::PixelFormat format) {
+    pixel_format = format;
+  }
+
+  /* The color correction shader is not needed if the renderer corrects the colors already. */
+  void SetColorCorrection(bool enable) {
+    color_correction = enable;
+  }
+
+  /* Upscales frames on the CPU before they are uploaded. Only for 32-bit pixel formats. */
+  void SetScaler(std::unique_ptr<common::Scaler> scaler) {
+    auto factor = scaler->Factor();
+
+    this->scaler = std::move(scaler);
+    scaled.resize(240 * factor * 160 * factor);
+  }
+
   void Draw(std::uint32_t* buffer) final;
 
+  /* The texture still holds the frame. */
+  void DrawUnchanged(std::uint32_t* buffer) final { }
+
   auto sizeHint() const -> QSize {
     return QSize{ 480, 320 };
   }
@@ -40,10 +68,10 @@ protected:
   void resizeGL(int width, int height) override;
 
 private slots:
-          void DrawSlot(std::uint32_t* buffer);
+          void DrawSlot();
 
   signals:
-          void SignalDraw(std::uint32_t* buffer);
+          void SignalDraw();
 
 private:
   auto CompileShader() -> GLuint;
@@ -52,6 +80,14 @@ private:
   int viewport_width = 0;
   int viewport_height = 0;
 
+  /* Frames are taken from here on the GUI thread, as the emulator may already be rendering the next. */
+  std::shared_ptr<FrameBuffer> frame_buffer;
+  nba::PixelFormat pixel_format = nba::PixelFormat::ARGB8888;
+  bool color_correction = true;
+
+  std::unique_ptr<common::Scaler> scaler;
+  std::vector<std::uint32_t> scaled;
+
   GLuint texture;
   GLuint program;
 };
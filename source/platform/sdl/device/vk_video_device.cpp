@@ -317,4 +317,5 @@ inline void SDL2_VK_VideoDevice::Draw(std::uint32_t* buffer) {
         present_info.pImageIndices = &image_index;
         vk_queue.presentKHR(present_info);
     }
+    ++frame_count;
 }
@@ -46,6 +46,8 @@ struct SDL2_VK_VideoDevice : public nba::VideoDevice {
     vk::UniqueSemaphore image_available_semaphore;
     vk::UniqueSemaphore blit_finished_semaphore;
 
+    std::uint64_t frame_count = 0;
+
     SDL2_VK_VideoDevice(const nba::Config& config);
     ~SDL2_VK_VideoDevice();
 
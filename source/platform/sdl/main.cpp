@@ -39,8 +39,9 @@ static constexpr auto kNativeHeight = 160;
 static SDL_Window* g_window;
 static SDL_GLContext g_gl_context;
 static GLuint g_gl_texture;
-static std::uint32_t g_framebuffer[kNativeWidth * kNativeHeight];
-static std::uint64_t g_frame_counter = 0;
+static std::shared_ptr<nba::VideoDevice::FrameBuffer> g_frame_buffer;
+// Frame count of the device that presents to the window, reset once per second.
+static std::uint64_t* g_frame_counter = nullptr;
 
 static std::atomic_bool g_sync_to_audio = true;
 static int g_cycles_per_audio_frame = 0;
@@ -75,9 +76,15 @@ struct CombinedInputDevice : public nba::InputDevice {
 };
 
 struct SDL2_VideoDevice : public nba::VideoDevice {
-    void Draw(std::uint32_t* buffer) final {
-        std::memcpy(g_framebuffer, buffer, sizeof(std::uint32_t) * kNativeWidth * kNativeHeight);
-        g_frame_counter++;
+    void SetFrameBuffer(std::shared_ptr<FrameBuffer> frame_buffer) final {
+        g_frame_buffer = frame_buffer;
+    }
+
+    // The Vulkan renderer presents its frames itself.
+    void Draw(std::uint32_t*) final {
+    }
+
+    void DrawUnchanged(std::uint32_t*) final {
     }
 };
 
@@ -88,10 +95,21 @@ struct CompositeVideoDevice : public nba::VideoDevice {
         devices.emplace_back(std::make_unique<SDL2_VK_VideoDevice>(*g_config));
     }
 
+    // The frame buffer supports a single consumer, so only the first device may acquire frames
+    // from it. All other devices receive the frames through Draw() only.
+    void SetFrameBuffer(std::shared_ptr<FrameBuffer> frame_buffer) final {
+        devices.front()->SetFrameBuffer(frame_buffer);
+    }
+
     void Draw(std::uint32_t* buffer) final {
         for (auto& device : devices)
             device->Draw(buffer);
     }
+
+    void DrawUnchanged(std::uint32_t* buffer) final {
+        for (auto& device : devices)
+            device->DrawUnchanged(buffer);
+    }
 };
 
 void load_game(std::string const& rom_path);
@@ -366,10 +384,32 @@ void init(int argc, char** argv) {
     audio_device->SetPassthrough((SDL_AudioCallback)audio_passthrough);
     g_config->audio_dev = audio_device;
     g_config->input_dev = std::make_shared<CombinedInputDevice>();
-    g_config->video_dev = std::make_shared<SDL2_VideoDevice>();
-    auto vulkan_frontend = std::make_shared<SDL2_VK_Frontend>(*g_config);
-    g_window = vulkan_frontend->GetWindow();
-    g_config->vulkan_frontend = vulkan_frontend;
+    switch (g_config->video.renderer) {
+    case nba::Config::Video::Renderer::Vulkan: {
+        auto vulkan_frontend = std::make_shared<SDL2_VK_Frontend>(*g_config);
+        g_window = vulkan_frontend->GetWindow();
+        g_frame_counter = &vulkan_frontend->frame_count;
+        g_config->video_dev = std::make_shared<SDL2_VideoDevice>();
+        g_config->vulkan_frontend = vulkan_frontend;
+        break;
+    }
+    case nba::Config::Video::Renderer::Software: {
+        // Frames rendered on the CPU are copied to a staging image and presented through Vulkan.
+        if (g_config->video.pixel_format != nba::PixelFormat::ARGB8888) {
+            LOG_WARN("The SDL frontend presents ARGB8888 frames only, using that pixel format.");
+            g_config->video.pixel_format = nba::PixelFormat::ARGB8888;
+        }
+        auto video_device = std::make_shared<SDL2_VK_VideoDevice>(*g_config);
+        g_window = video_device->window.get();
+        g_frame_counter = &video_device->frame_count;
+        g_config->video_dev = video_device;
+        break;
+    }
+    case nba::Config::Video::Renderer::Null:
+        fmt::print("The null renderer outputs no frames, select the Vulkan or software renderer "
+                   "in config.toml.\n");
+        std::exit(-1);
+    }
     g_emulator = std::make_unique<nba::Emulator>(g_config);
     g_emulator->Reset();
     load_game(g_game_path);
@@ -393,7 +433,7 @@ void loop() {
         //glClear(GL_COLOR_BUFFER_BIT);
         //glBindTexture(GL_TEXTURE_2D, g_gl_texture);
         //glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, kNativeWidth, kNativeHeight, 0, GL_BGRA,
-        //             GL_UNSIGNED_BYTE, g_framebuffer);
+        //             GL_UNSIGNED_BYTE, g_frame_buffer->Acquire().data());
         //glBegin(GL_QUADS);
         //glTexCoord2f(0, 0);
         //glVertex2f(-1.0f, 1.0f);
@@ -405,8 +445,7 @@ void loop() {
         //glVertex2f(-1.0f, -1.0f);
         //glEnd();
         //SDL_GL_SwapWindow(g_window);
-        std::uint64_t& frame_counter =
-            g_config->vulkan_frontend ? g_config->vulkan_frontend->frame_count : g_frame_counter;
+        std::uint64_t& frame_counter = *g_frame_counter;
         auto ticks_end = SDL_GetTicks();
         if ((ticks_end - ticks_start) >= 1000) {
             auto title = fmt::format("NanoboyAdvance [{0} fps | {1}%]", frame_counter,